@@ -0,0 +1,72 @@
+import time
+
+import glnext
+import numpy as np
+
+instance = glnext.instance()
+
+count = 1 << 22
+runs = 10
+
+rng = np.random.default_rng(0)
+keys = rng.integers(0, 1 << 32, count, dtype=np.uint32)
+values = rng.integers(0, 100, count, dtype=np.uint32)
+mask = (rng.random(count) < 0.5).astype(np.uint32)
+
+
+def bench(name, run, reference):
+    run()
+    start = time.perf_counter()
+    for _ in range(runs):
+        run()
+    gpu = (time.perf_counter() - start) / runs
+
+    reference()
+    start = time.perf_counter()
+    for _ in range(runs):
+        reference()
+    cpu = (time.perf_counter() - start) / runs
+
+    print(f'{name:8} glnext {gpu * 1000.0:8.3f} ms  numpy {cpu * 1000.0:8.3f} ms  speedup {cpu / gpu:6.2f}x')
+
+
+def storage(data):
+    buffer = instance.buffer('storage_buffer', data.nbytes, readable=True)
+    buffer.write(data)
+    return buffer
+
+
+scan_input = storage(values)
+scan_task = instance.task()
+scan_output = scan_task.scan(scan_input, count)
+scan_task.run()
+assert np.array_equal(np.frombuffer(scan_output.read(), 'u4'), np.cumsum(values, dtype=np.uint32))
+bench('scan', scan_task.run, lambda: np.cumsum(values))
+
+reduce_task = instance.task()
+reduce_output = reduce_task.reduce(scan_input, count, op='max')
+reduce_task.run()
+assert np.frombuffer(reduce_output.read(), 'u4')[0] == values.max()
+bench('reduce', reduce_task.run, lambda: values.max())
+
+mask_input = storage(mask)
+compact_task = instance.task()
+compact_output, compact_count = compact_task.compact(scan_input, count, mask=mask_input)
+compact_task.run()
+survivors = np.frombuffer(compact_count.read(), 'u4')[0]
+assert np.array_equal(np.frombuffer(compact_output.read(), 'u4')[:survivors], values[mask != 0])
+bench('compact', compact_task.run, lambda: values[mask != 0])
+
+sort_input = instance.buffer('storage_buffer', keys.nbytes, readable=True)
+sort_task = instance.task()
+sort_task.sort(sort_input, count)
+
+
+def sort():
+    sort_input.write(keys)
+    sort_task.run()
+
+
+sort()
+assert np.array_equal(np.frombuffer(sort_input.read(), 'u4'), np.sort(keys))
+bench('sort', sort, lambda: np.sort(keys, kind='stable'))
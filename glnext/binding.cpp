@@ -52,6 +52,14 @@ int parse_descriptor_binding(Instance * instance, DescriptorBinding * binding, P
         binding->is_buffer = true;
     }
 
+    if (!PyUnicode_CompareWithASCIIString(binding->type, "dynamic_uniform_buffer")) {
+        binding->descriptor_type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        binding->buffer.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        binding->buffer.mode = BUF_UNIFORM;
+        binding->buffer.dynamic = true;
+        binding->is_buffer = true;
+    }
+
     if (!PyUnicode_CompareWithASCIIString(binding->type, "storage_buffer")) {
         binding->descriptor_type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         binding->buffer.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
@@ -87,6 +95,13 @@ int parse_descriptor_binding(Instance * instance, DescriptorBinding * binding, P
         binding->is_image = true;
     }
 
+    if (!PyUnicode_CompareWithASCIIString(binding->type, "input_attachment")) {
+        binding->descriptor_type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        binding->image.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        binding->image.sampled = false;
+        binding->is_image = true;
+    }
+
     if (!binding->is_buffer && !binding->is_image) {
         PyErr_Format(PyExc_ValueError, "type");
         return -1;
@@ -123,10 +138,39 @@ int parse_descriptor_binding(Instance * instance, DescriptorBinding * binding, P
             return -1;
         }
 
+        if (binding->buffer.dynamic) {
+            // Dynamic bindings are only ever written by name through update.
+            if (!binding->name) {
+                PyErr_Format(PyExc_ValueError, "name");
+                return -1;
+            }
+
+            if (!binding->is_new) {
+                PyErr_Format(PyExc_ValueError, "size");
+                return -1;
+            }
+
+            binding->buffer.slot_count = 4;
+
+            if (PyObject * slots = PyDict_GetItemString(obj, "slots")) {
+                binding->buffer.slot_count = PyLong_AsUnsignedLong(slots);
+
+                if (PyErr_Occurred() || !binding->buffer.slot_count) {
+                    PyErr_Format(PyExc_ValueError, "slots");
+                    return -1;
+                }
+            }
+
+            // Every update writes a fresh slot of the ring, each slot is aligned for the dynamic offset.
+            VkDeviceSize alignment = instance->physical_device_properties.limits.minUniformBufferOffsetAlignment;
+            alignment = alignment ? alignment : 1;
+            binding->buffer.stride = (binding->buffer.size + alignment - 1) / alignment * alignment;
+        }
+
         binding->buffer.descriptor_buffer_info = {
             NULL,
             0,
-            VK_WHOLE_SIZE,
+            binding->buffer.dynamic ? binding->buffer.size : VK_WHOLE_SIZE,
         };
 
         binding->write_descriptor_set = {
@@ -574,7 +618,7 @@ int parse_descriptor_binding(Instance * instance, DescriptorBinding * binding, P
             binding->binding,
             binding->descriptor_type,
             binding->image.image_count,
-            VK_SHADER_STAGE_ALL,
+            binding->descriptor_type == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT ? VK_SHADER_STAGE_FRAGMENT_BIT : VK_SHADER_STAGE_ALL,
             NULL,
         };
     }
@@ -583,6 +627,16 @@ int parse_descriptor_binding(Instance * instance, DescriptorBinding * binding, P
 }
 
 void create_descriptor_binding_objects(Instance * instance, DescriptorBinding * binding, Memory * memory) {
+    if (binding->is_buffer && binding->buffer.dynamic) {
+        binding->buffer.buffer = new_buffer({
+            instance,
+            new_memory(instance, true),
+            binding->buffer.stride * binding->buffer.slot_count,
+            binding->buffer.usage,
+        });
+        return;
+    }
+
     if (binding->is_buffer && binding->is_new) {
         binding->buffer.buffer = new_buffer({
             instance,
@@ -594,6 +648,9 @@ void create_descriptor_binding_objects(Instance * instance, DescriptorBinding *
 }
 
 void bind_descriptor_binding_objects(Instance * instance, DescriptorBinding * binding) {
+    if (binding->is_buffer && binding->buffer.dynamic) {
+        allocate_memory(binding->buffer.buffer->memory);
+    }
     if (binding->is_buffer) {
         if (binding->is_new) {
             bind_buffer(binding->buffer.buffer);
@@ -628,3 +685,72 @@ void bind_descriptor_binding_objects(Instance * instance, DescriptorBinding * bi
         }
     }
 }
+
+int write_dynamic_binding(Instance * instance, uint32_t binding_count, DescriptorBinding * binding_array, PyObject * name, PyObject * value) {
+    for (uint32_t i = 0; i < binding_count; ++i) {
+        DescriptorBinding * binding = &binding_array[i];
+
+        if (!binding->buffer.dynamic || !binding->name || PyUnicode_Compare(binding->name, name)) {
+            continue;
+        }
+
+        Py_buffer view = {};
+        if (PyObject_GetBuffer(value, &view, PyBUF_STRIDED_RO)) {
+            return -1;
+        }
+
+        if ((VkDeviceSize)view.len != binding->buffer.size) {
+            PyBuffer_Release(&view);
+            PyErr_Format(PyExc_ValueError, "wrong size");
+            return -1;
+        }
+
+        // Commands of a group are submitted together, every update within a group must use a distinct slot.
+        if (instance->group) {
+            if (binding->buffer.group_index != instance->group_index) {
+                binding->buffer.group_index = instance->group_index;
+                binding->buffer.group_writes = 0;
+            }
+
+            if (binding->buffer.group_writes == binding->buffer.slot_count) {
+                PyBuffer_Release(&view);
+                PyErr_Format(PyExc_RuntimeError, "too many updates within a group");
+                return -1;
+            }
+
+            binding->buffer.group_writes += 1;
+        }
+
+        Buffer * buffer = binding->buffer.buffer;
+        binding->buffer.slot = (binding->buffer.slot + 1) % binding->buffer.slot_count;
+        char * ptr = (char *)buffer->memory->ptr + buffer->offset + binding->buffer.stride * binding->buffer.slot;
+        PyBuffer_ToContiguous(ptr, &view, view.len, 'C');
+        PyBuffer_Release(&view);
+        return 1;
+    }
+
+    return 0;
+}
+
+uint32_t get_dynamic_offsets(uint32_t binding_count, DescriptorBinding * binding_array, uint32_t * offset_array) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < binding_count; ++i) {
+        if (!binding_array[i].buffer.dynamic) {
+            continue;
+        }
+
+        // Dynamic offsets are ordered by binding number.
+        uint32_t index = 0;
+        for (uint32_t j = 0; j < binding_count; ++j) {
+            if (binding_array[j].buffer.dynamic && binding_array[j].binding < binding_array[i].binding) {
+                index += 1;
+            }
+        }
+
+        offset_array[index] = (uint32_t)(binding_array[i].buffer.stride * binding_array[i].buffer.slot);
+        count += 1;
+    }
+
+    return count;
+}
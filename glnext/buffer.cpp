@@ -50,7 +50,7 @@ Buffer * Instance_meth_buffer(Instance * self, PyObject * vargs, PyObject * kwar
     }
 
     if (!PyUnicode_CompareWithASCIIString(args.type, "indirect_buffer")) {
-        buffer_usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+        buffer_usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
     }
 
     if (!PyUnicode_CompareWithASCIIString(args.type, "storage_buffer")) {
@@ -61,6 +61,10 @@ Buffer * Instance_meth_buffer(Instance * self, PyObject * vargs, PyObject * kwar
         buffer_usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
     }
 
+    if (!PyUnicode_CompareWithASCIIString(args.type, "condition_buffer")) {
+        buffer_usage = VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
+
     if (!buffer_usage) {
         PyErr_Format(PyExc_ValueError, "type");
         return NULL;
@@ -167,6 +171,181 @@ PyObject * Buffer_meth_write(Buffer * self, PyObject * arg) {
     Py_RETURN_NONE;
 }
 
+const VkDeviceSize stream_chunk_size = 1 << 20;
+const uint32_t stream_chunk_count = 4;
+const VkDeviceSize readahead_page_size = 4096;
+
+void readahead_worker(const char * ptr, VkDeviceSize size, VkDeviceSize window, std::atomic<VkDeviceSize> * consumed) {
+    volatile char sink = 0;
+    for (VkDeviceSize position = 0; position < size; position += readahead_page_size) {
+        while (position > consumed->load() + window) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        sink = sink + ptr[position];
+    }
+}
+
+PyObject * Buffer_meth_write_file(Buffer * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {"path", "file_offset", "size", "offset", "readahead", NULL};
+
+    struct {
+        PyObject * path;
+        VkDeviceSize file_offset = 0;
+        PyObject * size = Py_None;
+        VkDeviceSize offset = 0;
+        VkBool32 readahead = true;
+    } args;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "O&|$KOKp",
+        keywords,
+        PyUnicode_FSConverter,
+        &args.path,
+        &args.file_offset,
+        &args.size,
+        &args.offset,
+        &args.readahead
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (self->instance->group) {
+        Py_DECREF(args.path);
+        PyErr_Format(PyExc_RuntimeError, "cannot stream files within a group");
+        return NULL;
+    }
+
+    MappedFile mapped = {};
+
+    if (!map_file(&mapped, PyBytes_AsString(args.path))) {
+        PyErr_Format(PyExc_OSError, "cannot open %s", PyBytes_AsString(args.path));
+        Py_DECREF(args.path);
+        return NULL;
+    }
+
+    Py_DECREF(args.path);
+
+    VkDeviceSize size = mapped.size > args.file_offset ? mapped.size - args.file_offset : 0;
+
+    if (args.size != Py_None) {
+        size = PyLong_AsUnsignedLongLong(args.size);
+        if (PyErr_Occurred()) {
+            unmap_file(&mapped);
+            return NULL;
+        }
+    }
+
+    if (args.file_offset > mapped.size || size > mapped.size - args.file_offset || args.offset > self->size || size > self->size - args.offset) {
+        unmap_file(&mapped);
+        PyErr_Format(PyExc_ValueError, "wrong size");
+        return NULL;
+    }
+
+    if (!size) {
+        unmap_file(&mapped);
+        Py_RETURN_NONE;
+    }
+
+    Instance * instance = self->instance;
+    const char * src = (const char *)mapped.ptr + args.file_offset;
+
+    VkDeviceSize chunk_size = size < stream_chunk_size ? size : stream_chunk_size;
+    uint32_t chunk_count = (uint32_t)((size + chunk_size - 1) / chunk_size);
+    uint32_t slot_count = chunk_count < stream_chunk_count ? chunk_count : stream_chunk_count;
+
+    HostBuffer temp = {};
+    new_temp_buffer(instance, &temp, chunk_size * slot_count);
+
+    VkCommandBuffer command_buffer_array[stream_chunk_count] = {};
+    VkFence fence_array[stream_chunk_count] = {};
+
+    VkCommandBufferAllocateInfo command_buffer_allocate_info = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        NULL,
+        instance->command_pool,
+        VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        slot_count,
+    };
+
+    instance->vkAllocateCommandBuffers(instance->device, &command_buffer_allocate_info, command_buffer_array);
+
+    for (uint32_t i = 0; i < slot_count; ++i) {
+        VkFenceCreateInfo fence_create_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, NULL, 0};
+        instance->vkCreateFence(instance->device, &fence_create_info, NULL, &fence_array[i]);
+    }
+
+    std::atomic<VkDeviceSize> consumed(0);
+    std::thread readahead;
+
+    if (args.readahead) {
+        readahead = std::thread(readahead_worker, src, size, chunk_size * slot_count, &consumed);
+    }
+
+    for (uint32_t i = 0; i < chunk_count; ++i) {
+        uint32_t slot = i % slot_count;
+        VkDeviceSize position = chunk_size * i;
+        VkDeviceSize length = size - position < chunk_size ? size - position : chunk_size;
+
+        Py_BEGIN_ALLOW_THREADS
+        if (i >= slot_count) {
+            instance->vkWaitForFences(instance->device, 1, &fence_array[slot], true, UINT64_MAX);
+            instance->vkResetFences(instance->device, 1, &fence_array[slot]);
+        }
+        memcpy((char *)temp.ptr + chunk_size * slot, src + position, (size_t)length);
+        Py_END_ALLOW_THREADS
+
+        consumed.store(position + length);
+
+        VkCommandBufferBeginInfo command_buffer_begin_info = {
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            NULL,
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            NULL,
+        };
+
+        instance->vkBeginCommandBuffer(command_buffer_array[slot], &command_buffer_begin_info);
+
+        VkBufferCopy copy = {chunk_size * slot, args.offset + position, length};
+        instance->vkCmdCopyBuffer(command_buffer_array[slot], temp.buffer, self->buffer, 1, &copy);
+
+        instance->vkEndCommandBuffer(command_buffer_array[slot]);
+
+        VkSubmitInfo submit_info = {
+            VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            NULL,
+            0,
+            NULL,
+            NULL,
+            1,
+            &command_buffer_array[slot],
+            0,
+            NULL,
+        };
+
+        instance->vkQueueSubmit(instance->queue, 1, &submit_info, fence_array[slot]);
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    instance->vkWaitForFences(instance->device, slot_count, fence_array, true, UINT64_MAX);
+    if (readahead.joinable()) {
+        readahead.join();
+    }
+    Py_END_ALLOW_THREADS
+
+    for (uint32_t i = 0; i < slot_count; ++i) {
+        instance->vkDestroyFence(instance->device, fence_array[i], NULL);
+    }
+
+    instance->vkFreeCommandBuffers(instance->device, instance->command_pool, slot_count, command_buffer_array);
+    free_temp_buffer(instance, &temp);
+    unmap_file(&mapped);
+    Py_RETURN_NONE;
+}
+
 PyObject * Buffer_get_size(Buffer * self) {
     return Py_BuildValue("K", self->size);
 }
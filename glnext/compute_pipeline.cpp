@@ -29,6 +29,12 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
         "compute_shader",
         "compute_count",
         "bindings",
+        "specialization",
+        "push_constants",
+        "condition_buffer",
+        "condition_offset",
+        "indirect_buffer",
+        "indirect_offset",
         "memory",
         NULL,
     };
@@ -37,6 +43,12 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
         PyObject * compute_shader = Py_None;
         uint32_t compute_count[3] = {};
         PyObject * bindings;
+        PyObject * specialization = Py_None;
+        uint32_t push_constants = 0;
+        PyObject * condition_buffer = Py_None;
+        VkDeviceSize condition_offset = 0;
+        PyObject * indirect_buffer = Py_None;
+        VkDeviceSize indirect_offset = 0;
         PyObject * memory = Py_None;
     } args;
 
@@ -45,13 +57,19 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
     int args_ok = PyArg_ParseTupleAndKeywords(
         vargs,
         kwargs,
-        "|$O!O&OO",
+        "|$O!O&OOIOKOKO",
         keywords,
         &PyBytes_Type,
         &args.compute_shader,
         parse_compute_count,
         args.compute_count,
         &args.bindings,
+        &args.specialization,
+        &args.push_constants,
+        &args.condition_buffer,
+        &args.condition_offset,
+        &args.indirect_buffer,
+        &args.indirect_offset,
         &args.memory
     );
 
@@ -63,7 +81,34 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
         return NULL;
     }
 
-    if (!args.compute_count[0] || !args.compute_count[1] || !args.compute_count[2]) {
+    Buffer * indirect_buffer = get_buffer(self, args.indirect_buffer);
+
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (indirect_buffer && !(indirect_buffer->usage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT)) {
+        PyErr_Format(PyExc_ValueError, "indirect_buffer");
+        return NULL;
+    }
+
+    if (indirect_buffer && (args.indirect_offset % 4 || args.indirect_offset + sizeof(VkDispatchIndirectCommand) > indirect_buffer->size)) {
+        PyErr_Format(PyExc_ValueError, "indirect_offset");
+        return NULL;
+    }
+
+    if (!indirect_buffer && (!args.compute_count[0] || !args.compute_count[1] || !args.compute_count[2])) {
+        return NULL;
+    }
+
+    if (args.push_constants % 4 || args.push_constants > self->physical_device_properties.limits.maxPushConstantsSize) {
+        PyErr_Format(PyExc_ValueError, "push_constants");
+        return NULL;
+    }
+
+    Buffer * condition_buffer = get_buffer(self, args.condition_buffer);
+
+    if (PyErr_Occurred() || !check_condition_buffer(self, condition_buffer, args.condition_offset)) {
         return NULL;
     }
 
@@ -73,6 +118,10 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
 
     res->instance = self;
     res->members = PyDict_New();
+    res->condition_buffer = condition_buffer;
+    res->condition_offset = args.condition_offset;
+    res->indirect_buffer = indirect_buffer;
+    res->indirect_offset = args.indirect_offset;
 
     res->parameters = {
         true,
@@ -110,30 +159,99 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
         res->write_descriptor_set_array[i] = res->binding_array[i].write_descriptor_set;
     }
 
-    VkPipelineLayoutCreateInfo pipeline_layout_create_info = {
-        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        NULL,
-        0,
-        0,
-        NULL,
-        0,
-        NULL,
-    };
+    res->dynamic_offset_array = allocate<uint32_t>(res->binding_count);
 
-    if (res->binding_count) {
-        VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info = {
-            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-            NULL,
-            0,
-            res->binding_count,
-            res->descriptor_binding_array,
+    uint32_t access_count = 2;
+    for (uint32_t i = 0; i < res->binding_count; ++i) {
+        access_count += res->binding_array[i].is_image ? res->binding_array[i].image.image_count : 1;
+    }
+
+    res->access_count = 0;
+    res->access_array = allocate<ResourceAccess>(access_count);
+
+    for (uint32_t i = 0; i < res->binding_count; ++i) {
+        DescriptorBinding * binding = &res->binding_array[i];
+
+        if (binding->is_buffer) {
+            VkAccessFlags access = VK_ACCESS_SHADER_READ_BIT;
+            VkBool32 write = false;
+
+            if (binding->buffer.mode == BUF_UNIFORM) {
+                access = VK_ACCESS_UNIFORM_READ_BIT;
+            }
+
+            if (binding->buffer.mode == BUF_OUTPUT) {
+                access = VK_ACCESS_SHADER_WRITE_BIT;
+                write = true;
+            }
+
+            if (binding->buffer.mode == BUF_STORAGE) {
+                access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                write = true;
+            }
+
+            res->access_array[res->access_count++] = {
+                (PyObject *)binding->buffer.buffer,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                access,
+                write,
+            };
+        }
+
+        if (binding->is_image) {
+            VkBool32 write = binding->descriptor_type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            VkAccessFlags access = VK_ACCESS_SHADER_READ_BIT;
+
+            if (write) {
+                access |= VK_ACCESS_SHADER_WRITE_BIT;
+            }
+
+            for (uint32_t j = 0; j < binding->image.image_count; ++j) {
+                res->access_array[res->access_count++] = {
+                    (PyObject *)binding->image.image_array[j],
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    access,
+                    write,
+                };
+            }
+        }
+    }
+
+    if (indirect_buffer) {
+        res->access_array[res->access_count++] = {
+            (PyObject *)indirect_buffer,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+            false,
         };
+    }
 
-        self->vkCreateDescriptorSetLayout(self->device, &descriptor_set_layout_create_info, NULL, &res->descriptor_set_layout);
+    if (condition_buffer) {
+        res->access_array[res->access_count++] = {
+            (PyObject *)condition_buffer,
+            VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT,
+            VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+            false,
+        };
+    }
 
-        pipeline_layout_create_info.setLayoutCount = 1;
-        pipeline_layout_create_info.pSetLayouts = &res->descriptor_set_layout;
+    res->push_constant_size = args.push_constants;
+    res->push_constant_data = allocate<char>(args.push_constants);
+    memset(res->push_constant_data, 0, args.push_constants);
 
+    VkPushConstantRange push_constant_range = {VK_SHADER_STAGE_COMPUTE_BIT, 0, args.push_constants};
+
+    PipelineLayout * pipeline_layout = get_pipeline_layout(
+        self,
+        res->binding_count,
+        res->descriptor_binding_array,
+        args.push_constants ? &push_constant_range : NULL
+    );
+
+    res->descriptor_set_layout = pipeline_layout->descriptor_set_layout;
+    res->pipeline_layout = pipeline_layout->pipeline_layout;
+
+    if (res->binding_count) {
         VkDescriptorPoolCreateInfo descriptor_pool_create_info = {
             VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
             NULL,
@@ -168,20 +286,18 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
         );
     }
 
-    self->vkCreatePipelineLayout(self->device, &pipeline_layout_create_info, NULL, &res->pipeline_layout);
+    VkShaderModule compute_shader_module = get_shader_module(self, args.compute_shader);
 
-    VkShaderModuleCreateInfo compute_shader_module_create_info = {
-        VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-        NULL,
-        0,
-        (VkDeviceSize)PyBytes_Size(args.compute_shader),
-        (uint32_t *)PyBytes_AsString(args.compute_shader),
-    };
+    res->pipeline = NULL;
+    res->pipeline_state = allocate<ComputePipelineState>(1);
 
-    VkShaderModule compute_shader_module = NULL;
-    self->vkCreateShaderModule(self->device, &compute_shader_module_create_info, NULL, &compute_shader_module);
+    if (!parse_specialization(&res->pipeline_state->specialization, args.specialization)) {
+        return NULL;
+    }
+
+    VkSpecializationInfo * specialization_info = &res->pipeline_state->specialization.info;
 
-    VkComputePipelineCreateInfo pipeline_create_info = {
+    res->pipeline_state->pipeline_create_info = {
         VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
         NULL,
         0,
@@ -192,16 +308,19 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
             VK_SHADER_STAGE_COMPUTE_BIT,
             compute_shader_module,
             "main",
-            NULL,
+            specialization_info->mapEntryCount ? specialization_info : NULL,
         },
         res->pipeline_layout,
         NULL,
         0,
     };
 
-    self->vkCreateComputePipelines(self->device, self->pipeline_cache, 1, &pipeline_create_info, NULL, &res->pipeline);
-
-    self->vkDestroyShaderModule(self->device, compute_shader_module, NULL);
+    if (self->deferred) {
+        PyList_Append(self->pending_list, (PyObject *)res);
+    } else {
+        self->vkCreateComputePipelines(self->device, self->pipeline_cache, 1, &res->pipeline_state->pipeline_create_info, NULL, &res->pipeline);
+        release_pipeline_state(res);
+    }
 
     for (uint32_t i = 0; i < res->binding_count; ++i) {
         if (res->binding_array[i].name) {
@@ -214,6 +333,11 @@ ComputePipeline * new_compute_pipeline(Instance * self, PyObject * vargs, PyObje
     return res;
 }
 
+void release_pipeline_state(ComputePipeline * self) {
+    PyMem_Free(self->pipeline_state);
+    self->pipeline_state = NULL;
+}
+
 ComputePipeline * Framebuffer_meth_compute(Framebuffer * self, PyObject * vargs, PyObject * kwargs) {
     if (!self->compute) {
         return NULL;
@@ -255,6 +379,27 @@ PyObject * ComputePipeline_meth_update(ComputePipeline * self, PyObject * vargs,
             self->parameters.z = compute_count[2];
             continue;
         }
+        if (!PyUnicode_CompareWithASCIIString(key, "push_constants")) {
+            Py_buffer view = {};
+            if (PyObject_GetBuffer(value, &view, PyBUF_STRIDED_RO)) {
+                return NULL;
+            }
+            if ((uint32_t)view.len != self->push_constant_size) {
+                PyBuffer_Release(&view);
+                PyErr_Format(PyExc_ValueError, "wrong size");
+                return NULL;
+            }
+            PyBuffer_ToContiguous(self->push_constant_data, &view, view.len, 'C');
+            PyBuffer_Release(&view);
+            continue;
+        }
+        int dynamic = write_dynamic_binding(self->instance, self->binding_count, self->binding_array, key, value);
+        if (dynamic < 0) {
+            return NULL;
+        }
+        if (dynamic) {
+            continue;
+        }
         PyObject * member = PyDict_GetItem(self->members, key);
         if (!member) {
             return NULL;
@@ -269,13 +414,127 @@ PyObject * ComputePipeline_meth_update(ComputePipeline * self, PyObject * vargs,
     Py_RETURN_NONE;
 }
 
-void execute_compute_pipeline(ComputePipeline * self, VkCommandBuffer command_buffer) {
+void compute_barrier(ComputePipeline * self, VkCommandBuffer command_buffer, ComputeState * state) {
+    VkPipelineStageFlags src_stage = 0;
+    VkPipelineStageFlags dst_stage = 0;
+    VkAccessFlags src_access = 0;
+    VkAccessFlags dst_access = 0;
+    bool covered[64] = {};
+
+    if (state->pending_stage && self->access_count) {
+        src_stage |= state->pending_stage;
+        src_access |= state->pending_access;
+        for (uint32_t i = 0; i < self->access_count; ++i) {
+            dst_stage |= self->access_array[i].stage;
+            dst_access |= self->access_array[i].access;
+        }
+    }
+
+    // Only read after write, write after write and write after read on the same resource need a barrier.
+    for (uint32_t i = 0; i < self->access_count; ++i) {
+        ResourceAccess * access = &self->access_array[i];
+        for (uint32_t j = 0; j < state->access_count; ++j) {
+            ResourceAccess * pending = &state->access_array[j];
+            if (pending->resource != access->resource || (!pending->write && !access->write)) {
+                continue;
+            }
+            src_stage |= pending->stage;
+            dst_stage |= access->stage;
+            covered[j] = true;
+            if (pending->write) {
+                src_access |= VK_ACCESS_SHADER_WRITE_BIT;
+                dst_access |= access->access;
+            }
+        }
+    }
+
+    if (src_stage) {
+        VkMemoryBarrier memory_barrier = {
+            VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            NULL,
+            src_access,
+            dst_access,
+        };
+
+        self->instance->vkCmdPipelineBarrier(
+            command_buffer,
+            src_stage,
+            dst_stage,
+            0,
+            1,
+            &memory_barrier,
+            0,
+            NULL,
+            0,
+            NULL
+        );
+
+        state->pending_stage = 0;
+        state->pending_access = 0;
+
+        // The barrier only makes the conflicting accesses available, unrelated writes still need one later.
+        uint32_t access_count = 0;
+        for (uint32_t j = 0; j < state->access_count; ++j) {
+            if (!covered[j]) {
+                state->access_array[access_count++] = state->access_array[j];
+            }
+        }
+        state->access_count = access_count;
+    }
+
+    // When the accesses do not fit the next dispatch conservatively waits for this one.
+    if (state->access_count + self->access_count > 64) {
+        state->pending_stage |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        state->pending_access |= VK_ACCESS_SHADER_WRITE_BIT;
+        state->access_count = 0;
+        return;
+    }
+
+    memcpy(state->access_array + state->access_count, self->access_array, sizeof(ResourceAccess) * self->access_count);
+    state->access_count += self->access_count;
+}
+
+void flush_compute_state(Instance * instance, VkCommandBuffer command_buffer, ComputeState * state) {
+    if (!state->pending_stage && !state->access_count) {
+        return;
+    }
+
+    VkMemoryBarrier memory_barrier = {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_SHADER_WRITE_BIT | state->pending_access,
+        VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+    };
+
+    instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1,
+        &memory_barrier,
+        0,
+        NULL,
+        0,
+        NULL
+    );
+
+    state->pending_stage = 0;
+    state->pending_access = 0;
+    state->access_count = 0;
+}
+
+void execute_compute_pipeline(ComputePipeline * self, VkCommandBuffer command_buffer, ComputeState * state) {
     if (!self->parameters.enabled) {
         return;
     }
 
+    compute_barrier(self, command_buffer, state);
+
     self->instance->vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, self->pipeline);
 
+    uint32_t dynamic_offset_count = get_dynamic_offsets(self->binding_count, self->binding_array, self->dynamic_offset_array);
+
     self->instance->vkCmdBindDescriptorSets(
         command_buffer,
         VK_PIPELINE_BIND_POINT_COMPUTE,
@@ -283,11 +542,34 @@ void execute_compute_pipeline(ComputePipeline * self, VkCommandBuffer command_bu
         0,
         1,
         &self->descriptor_set,
-        0,
-        NULL
+        dynamic_offset_count,
+        self->dynamic_offset_array
     );
 
-    self->instance->vkCmdDispatch(command_buffer, self->parameters.x, self->parameters.x, self->parameters.z);
+    if (self->push_constant_size) {
+        self->instance->vkCmdPushConstants(
+            command_buffer,
+            self->pipeline_layout,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            0,
+            self->push_constant_size,
+            self->push_constant_data
+        );
+    }
+
+    if (self->condition_buffer) {
+        begin_conditional_rendering(self->instance, command_buffer, self->condition_buffer, self->condition_offset);
+    }
+
+    if (self->indirect_buffer) {
+        self->instance->vkCmdDispatchIndirect(command_buffer, self->indirect_buffer->buffer, self->indirect_offset);
+    } else {
+        self->instance->vkCmdDispatch(command_buffer, self->parameters.x, self->parameters.y, self->parameters.z);
+    }
+
+    if (self->condition_buffer) {
+        self->instance->vkCmdEndConditionalRenderingEXT(command_buffer);
+    }
 }
 
 PyObject * ComputePipeline_subscript(ComputePipeline * self, PyObject * key) {
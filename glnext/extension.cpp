@@ -100,6 +100,15 @@ uint32_t load_device_extensions(Instance * instance, const char ** array, const
         instance->extension.dedicated_allocation = true;
     }
 
+    if (instance->api_version >= VK_API_VERSION_1_1) {
+        instance->extension.multiview = true;
+    }
+
+    if (instance->api_version < VK_API_VERSION_1_1 && has_key(extensions, "VK_KHR_multiview")) {
+        array[count++] = "VK_KHR_multiview";
+        instance->extension.multiview = true;
+    }
+
     if (instance->api_version < VK_API_VERSION_1_2 && has_key(extensions, "VK_KHR_spirv_1_4")) {
         array[count++] = "VK_KHR_spirv_1_4";
     }
@@ -109,6 +118,24 @@ uint32_t load_device_extensions(Instance * instance, const char ** array, const
         instance->extension.draw_indirect_count = true;
     }
 
+    if (instance->api_version >= VK_API_VERSION_1_3) {
+        instance->extension.dynamic_rendering = true;
+    }
+
+    if (instance->api_version >= VK_API_VERSION_1_2 && instance->api_version < VK_API_VERSION_1_3 && has_key(extensions, "VK_KHR_dynamic_rendering")) {
+        array[count++] = "VK_KHR_dynamic_rendering";
+        instance->extension.dynamic_rendering = true;
+    }
+
+    if (instance->api_version >= VK_API_VERSION_1_2) {
+        instance->extension.shader_float16_int8 = true;
+    }
+
+    if (instance->api_version < VK_API_VERSION_1_2 && has_key(extensions, "VK_KHR_shader_float16_int8")) {
+        array[count++] = "VK_KHR_shader_float16_int8";
+        instance->extension.shader_float16_int8 = true;
+    }
+
     if (has_key(extensions, "VK_KHR_deferred_host_operations")) {
         array[count++] = "VK_KHR_deferred_host_operations";
         instance->extension.deferred_host_operations = true;
@@ -129,11 +156,21 @@ uint32_t load_device_extensions(Instance * instance, const char ** array, const
         instance->extension.pipeline_library = true;
     }
 
+    if (instance->extension.pipeline_library && has_key(extensions, "VK_EXT_graphics_pipeline_library")) {
+        array[count++] = "VK_EXT_graphics_pipeline_library";
+        instance->extension.graphics_pipeline_library = true;
+    }
+
     if (has_key(extensions, "VK_KHR_ray_tracing_pipeline")) {
         array[count++] = "VK_KHR_ray_tracing_pipeline";
         instance->extension.ray_tracing_pipeline = true;
     }
 
+    if (has_key(extensions, "VK_EXT_conditional_rendering")) {
+        array[count++] = "VK_EXT_conditional_rendering";
+        instance->extension.conditional_rendering = true;
+    }
+
     if (has_key(extensions, "VK_NV_mesh_shader")) {
         array[count++] = "VK_NV_mesh_shader";
         instance->extension.mesh_shader = true;
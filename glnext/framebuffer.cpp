@@ -1,5 +1,28 @@
 #include "glnext.hpp"
 
+int parse_subpass_attachments(PyObject * subpass, const char * name, uint32_t output_count, uint32_t * array) {
+    PyObject * obj = PyDict_GetItemString(subpass, name);
+    if (!obj) {
+        return 0;
+    }
+
+    if (!PyList_CheckExact(obj) || PyList_Size(obj) > output_count) {
+        PyErr_Format(PyExc_ValueError, name);
+        return -1;
+    }
+
+    uint32_t count = (uint32_t)PyList_Size(obj);
+    for (uint32_t i = 0; i < count; ++i) {
+        array[i] = PyLong_AsUnsignedLong(PyList_GetItem(obj, i));
+        if (PyErr_Occurred() || array[i] >= output_count) {
+            PyErr_Format(PyExc_ValueError, name);
+            return -1;
+        }
+    }
+
+    return count;
+}
+
 Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwargs) {
     static char * keywords[] = {
         "size",
@@ -9,7 +32,14 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         "layers",
         "depth",
         "compute",
+        "sort",
+        "multiview",
+        "dynamic",
+        "load",
+        "store",
+        "subpasses",
         "mode",
+        "filter",
         "memory",
         NULL
     };
@@ -23,7 +53,14 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         uint32_t layers = 1;
         VkBool32 depth = true;
         VkBool32 compute = false;
+        VkBool32 sort = false;
+        VkBool32 multiview = false;
+        VkBool32 dynamic = false;
+        PyObject * load = NULL;
+        PyObject * store = NULL;
+        PyObject * subpasses = Py_None;
         PyObject * mode;
+        PyObject * filter = NULL;
         PyObject * memory = Py_None;
     } args;
 
@@ -33,7 +70,7 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
     int args_ok = PyArg_ParseTupleAndKeywords(
         vargs,
         kwargs,
-        "(II)|O!$IIIppOO",
+        "(II)|O!$IIIpppppO!O!OOO!O",
         keywords,
         &args.width,
         &args.height,
@@ -44,7 +81,17 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         &args.layers,
         &args.depth,
         &args.compute,
+        &args.sort,
+        &args.multiview,
+        &args.dynamic,
+        &PyUnicode_Type,
+        &args.load,
+        &PyUnicode_Type,
+        &args.store,
+        &args.subpasses,
         &args.mode,
+        &PyUnicode_Type,
+        &args.filter,
         &args.memory
     );
 
@@ -55,9 +102,100 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
     Memory * memory = get_memory(self, args.memory);
     PyObject * format_list = PyUnicode_Split(args.format, NULL, -1);
     ImageMode image_mode = get_image_mode(args.mode);
+    MipmapFilter filter = args.filter ? get_mipmap_filter(args.filter) : MIP_BOX;
+
+    if (filter == MIP_INVALID) {
+        PyErr_Format(PyExc_ValueError, "filter");
+        return NULL;
+    }
 
     uint32_t output_count = (uint32_t)PyList_Size(format_list);
     uint32_t attachment_count = output_count;
+
+    VkAttachmentLoadOp load_op_array[64];
+    VkAttachmentStoreOp store_op_array[64];
+
+    PyObject * load_list = args.load ? PyUnicode_Split(args.load, NULL, -1) : NULL;
+    PyObject * store_list = args.store ? PyUnicode_Split(args.store, NULL, -1) : NULL;
+
+    if (load_list && PyList_Size(load_list) != 1 && PyList_Size(load_list) != output_count) {
+        PyErr_Format(PyExc_ValueError, "load");
+        return NULL;
+    }
+
+    if (store_list && PyList_Size(store_list) != 1 && PyList_Size(store_list) != output_count) {
+        PyErr_Format(PyExc_ValueError, "store");
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < output_count; ++i) {
+        load_op_array[i] = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        store_op_array[i] = VK_ATTACHMENT_STORE_OP_STORE;
+
+        if (load_list) {
+            load_op_array[i] = get_load_op(PyList_GetItem(load_list, PyList_Size(load_list) > 1 ? i : 0));
+            if (load_op_array[i] == VK_ATTACHMENT_LOAD_OP_MAX_ENUM) {
+                PyErr_Format(PyExc_ValueError, "load");
+                return NULL;
+            }
+        }
+
+        if (store_list) {
+            store_op_array[i] = get_store_op(PyList_GetItem(store_list, PyList_Size(store_list) > 1 ? i : 0));
+            if (store_op_array[i] == VK_ATTACHMENT_STORE_OP_MAX_ENUM) {
+                PyErr_Format(PyExc_ValueError, "store");
+                return NULL;
+            }
+        }
+    }
+
+    Py_XDECREF(load_list);
+    Py_XDECREF(store_list);
+
+    uint32_t subpass_count = 1;
+    uint32_t subpass_output_count_array[16] = {output_count};
+    uint32_t subpass_input_count_array[16] = {};
+    uint32_t subpass_output_array[16][64];
+    uint32_t subpass_input_array[16][64];
+
+    for (uint32_t i = 0; i < output_count; ++i) {
+        subpass_output_array[0][i] = i;
+    }
+
+    if (args.subpasses != Py_None) {
+        if (!PyList_CheckExact(args.subpasses) || !PyList_Size(args.subpasses) || PyList_Size(args.subpasses) > 16) {
+            PyErr_Format(PyExc_ValueError, "subpasses");
+            return NULL;
+        }
+
+        // Input attachments are read from the first framebuffer, every layer needs its own subpass chain otherwise.
+        if (args.samples > 1 || (args.layers > 1 && !args.multiview)) {
+            PyErr_Format(PyExc_ValueError, "subpasses");
+            return NULL;
+        }
+
+        subpass_count = (uint32_t)PyList_Size(args.subpasses);
+
+        for (uint32_t i = 0; i < subpass_count; ++i) {
+            PyObject * subpass = PyList_GetItem(args.subpasses, i);
+
+            if (!PyDict_CheckExact(subpass)) {
+                PyErr_Format(PyExc_ValueError, "subpasses");
+                return NULL;
+            }
+
+            int outputs = parse_subpass_attachments(subpass, "outputs", output_count, subpass_output_array[i]);
+            int inputs = parse_subpass_attachments(subpass, "inputs", output_count, subpass_input_array[i]);
+
+            if (outputs < 0 || inputs < 0) {
+                return NULL;
+            }
+
+            subpass_output_count_array[i] = outputs;
+            subpass_input_count_array[i] = inputs;
+        }
+    }
+
     uint32_t image_barrier_count = 0;
 
     if (args.depth) {
@@ -83,6 +221,14 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         final_image_layout = VK_IMAGE_LAYOUT_GENERAL;
     }
 
+    if (image_mode == IMG_OUTPUT) {
+        image_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    }
+
+    if (subpass_count > 1) {
+        image_usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    }
+
     if (args.compute) {
         image_barrier_count = output_count;
         image_usage |= VK_IMAGE_USAGE_STORAGE_BIT;
@@ -92,6 +238,15 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         image_usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
     }
 
+    VkBool32 multiview = args.multiview && args.layers > 1 && args.layers <= self->max_multiview_view_count;
+
+    if (subpass_count > 1 && args.layers > 1 && !multiview) {
+        PyErr_Format(PyExc_ValueError, "subpasses");
+        return NULL;
+    }
+
+    uint32_t framebuffer_count = multiview ? 1 : args.layers;
+
     Framebuffer * res = PyObject_New(Framebuffer, self->state->Framebuffer_type);
 
     res->instance = self;
@@ -102,14 +257,20 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
     res->layers = args.layers;
     res->depth = args.depth;
     res->compute = args.compute;
+    res->sort = args.sort;
+    res->multiview = multiview;
+    res->dynamic = args.dynamic && self->extension.dynamic_rendering && subpass_count == 1;
+    res->subpass_count = subpass_count;
+    memcpy(res->subpass_output_count_array, subpass_output_count_array, sizeof(subpass_output_count_array));
+    res->framebuffer_count = framebuffer_count;
     res->mode = image_mode;
     res->image_barrier_count = image_barrier_count;
     res->attachment_count = attachment_count;
     res->output_count = output_count;
 
     res->image_array = (Image **)PyMem_Malloc(sizeof(Image *) * attachment_count);
-    res->image_view_array = (VkImageView *)PyMem_Malloc(sizeof(VkImageView) * attachment_count * args.layers);
-    res->framebuffer_array = (VkFramebuffer *)PyMem_Malloc(sizeof(VkFramebuffer) * args.layers);
+    res->image_view_array = (VkImageView *)PyMem_Malloc(sizeof(VkImageView) * attachment_count * framebuffer_count);
+    res->framebuffer_array = (VkFramebuffer *)PyMem_Malloc(sizeof(VkFramebuffer) * framebuffer_count);
     res->description_array = (VkAttachmentDescription *)PyMem_Malloc(sizeof(VkAttachmentDescription) * attachment_count);
     res->reference_array = (VkAttachmentReference *)PyMem_Malloc(sizeof(VkAttachmentReference) * attachment_count);
     res->clear_value_array = (VkClearValue *)PyMem_Malloc(sizeof(VkClearValue) * attachment_count);
@@ -132,6 +293,7 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
             args.layers,
             image_mode,
             format.format,
+            filter,
         });
     }
 
@@ -228,6 +390,27 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         subpass_description.pResolveAttachments = res->reference_array;
     }
 
+    // Loaded outputs start the pass in the layout the previous run left them in.
+    VkImageLayout resting_image_layout = args.levels > 1 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : final_image_layout;
+    bool load_outputs = false;
+
+    for (uint32_t i = 0; i < output_count; ++i) {
+        VkAttachmentDescription * description = &res->description_array[i];
+
+        if (args.samples > 1) {
+            description = &res->description_array[attachment_count - output_count + i];
+            description->storeOp = load_op_array[i] == VK_ATTACHMENT_LOAD_OP_LOAD ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        }
+
+        description->loadOp = load_op_array[i];
+        res->description_array[i].storeOp = store_op_array[i];
+
+        if (load_op_array[i] == VK_ATTACHMENT_LOAD_OP_LOAD) {
+            description->initialLayout = args.samples > 1 ? description->finalLayout : resting_image_layout;
+            load_outputs = true;
+        }
+    }
+
     VkSubpassDependency subpass_dependency = {
         VK_SUBPASS_EXTERNAL,
         0,
@@ -238,21 +421,118 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         0,
     };
 
+    VkSubpassDescription subpass_array[16] = {subpass_description};
+    VkSubpassDependency subpass_dependency_array[16] = {subpass_dependency};
+    VkAttachmentReference color_reference_array[16][64];
+    VkAttachmentReference input_reference_array[16][64];
+    uint32_t preserve_array[16][64];
+
+    VkDependencyFlags subpass_dependency_flags = VK_DEPENDENCY_BY_REGION_BIT;
+    if (multiview) {
+        subpass_dependency_flags |= VK_DEPENDENCY_VIEW_LOCAL_BIT;
+    }
+
+    if (args.subpasses != Py_None) {
+        uint32_t first_use_array[64];
+
+        for (uint32_t i = 0; i < output_count; ++i) {
+            first_use_array[i] = subpass_count;
+        }
+
+        for (uint32_t i = subpass_count; i-- > 0;) {
+            for (uint32_t j = 0; j < subpass_output_count_array[i]; ++j) {
+                first_use_array[subpass_output_array[i][j]] = i;
+            }
+            for (uint32_t j = 0; j < subpass_input_count_array[i]; ++j) {
+                first_use_array[subpass_input_array[i][j]] = i;
+            }
+        }
+
+        for (uint32_t i = 0; i < subpass_count; ++i) {
+            bool used_array[64] = {};
+
+            for (uint32_t j = 0; j < subpass_output_count_array[i]; ++j) {
+                color_reference_array[i][j] = {subpass_output_array[i][j], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+                used_array[subpass_output_array[i][j]] = true;
+            }
+
+            for (uint32_t j = 0; j < subpass_input_count_array[i]; ++j) {
+                input_reference_array[i][j] = {subpass_input_array[i][j], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+                used_array[subpass_input_array[i][j]] = true;
+            }
+
+            // Outputs written by an earlier subpass keep their content until the end of the render pass.
+            uint32_t preserve_count = 0;
+            for (uint32_t j = 0; j < output_count; ++j) {
+                if (!used_array[j] && first_use_array[j] < i) {
+                    preserve_array[i][preserve_count++] = j;
+                }
+            }
+
+            subpass_array[i] = {
+                0,
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                subpass_input_count_array[i],
+                input_reference_array[i],
+                subpass_output_count_array[i],
+                color_reference_array[i],
+                NULL,
+                subpass_description.pDepthStencilAttachment,
+                preserve_count,
+                preserve_array[i],
+            };
+
+            if (i) {
+                subpass_dependency_array[i] = {
+                    i - 1,
+                    i,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    subpass_dependency_flags,
+                };
+            }
+        }
+    }
+
+    uint32_t view_mask = get_view_mask(args.layers);
+    uint32_t view_mask_array[16];
+
+    for (uint32_t i = 0; i < subpass_count; ++i) {
+        view_mask_array[i] = view_mask;
+    }
+
+    VkRenderPassMultiviewCreateInfo multiview_create_info = {
+        VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO,
+        NULL,
+        subpass_count,
+        view_mask_array,
+        0,
+        NULL,
+        1,
+        &view_mask,
+    };
+
     VkRenderPassCreateInfo render_pass_create_info = {
         VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-        NULL,
+        multiview ? &multiview_create_info : NULL,
         0,
         attachment_count,
         res->description_array,
-        1,
-        &subpass_description,
-        1,
-        &subpass_dependency,
+        subpass_count,
+        subpass_array,
+        subpass_count,
+        subpass_dependency_array,
     };
 
-    self->vkCreateRenderPass(res->instance->device, &render_pass_create_info, NULL, &res->render_pass);
+    res->render_pass = NULL;
 
-    for (uint32_t layer = 0; layer < args.layers; ++layer) {
+    if (!res->dynamic) {
+        res->render_pass = get_render_pass(self, &render_pass_create_info);
+    }
+
+    for (uint32_t layer = 0; layer < framebuffer_count; ++layer) {
         uint32_t offset = attachment_count * layer;
 
         for (uint32_t i = 0; i < attachment_count; ++i) {
@@ -261,10 +541,10 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
                 NULL,
                 0,
                 res->image_array[i]->image,
-                VK_IMAGE_VIEW_TYPE_2D,
+                multiview ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
                 res->image_array[i]->format,
                 {VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A},
-                {res->image_array[i]->aspect, 0, 1, layer, 1},
+                {res->image_array[i]->aspect, 0, 1, layer, multiview ? args.layers : 1},
             };
 
             VkImageView image_view = NULL;
@@ -272,6 +552,10 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
             res->image_view_array[offset + i] = image_view;
         }
 
+        if (res->dynamic) {
+            continue;
+        }
+
         VkFramebufferCreateInfo framebuffer_create_info = {
             VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
             NULL,
@@ -308,6 +592,44 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
         res->clear_value_array[output_count] = {1.0f, 0};
     }
 
+    if (load_outputs) {
+        begin_commands(self);
+
+        for (uint32_t i = 0; i < attachment_count; ++i) {
+            if (res->description_array[i].initialLayout == VK_IMAGE_LAYOUT_UNDEFINED) {
+                continue;
+            }
+
+            VkImageMemoryBarrier image_barrier = {
+                VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                NULL,
+                0,
+                0,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                res->description_array[i].initialLayout,
+                VK_QUEUE_FAMILY_IGNORED,
+                VK_QUEUE_FAMILY_IGNORED,
+                res->image_array[i]->image,
+                {res->image_array[i]->aspect, 0, res->image_array[i]->levels, 0, args.layers},
+            };
+
+            self->vkCmdPipelineBarrier(
+                self->command_buffer,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                0,
+                0,
+                NULL,
+                0,
+                NULL,
+                1,
+                &image_barrier
+            );
+        }
+
+        end_commands(self);
+    }
+
     res->output = PyTuple_New(output_count);
     for (uint32_t i = 0; i < output_count; ++i) {
         PyTuple_SetItem(res->output, i, (PyObject *)res->image_array[i]);
@@ -317,6 +639,60 @@ Framebuffer * new_framebuffer(Instance * self, PyObject * vargs, PyObject * kwar
     return res;
 }
 
+void append_attachment_references(PyObject * key, uint32_t count, const VkAttachmentReference * reference_array) {
+    append_key(key, &count, sizeof(uint32_t));
+    if (reference_array) {
+        append_key(key, reference_array, sizeof(VkAttachmentReference) * count);
+    }
+}
+
+VkRenderPass get_render_pass(Instance * self, VkRenderPassCreateInfo * info) {
+    PyObject * key = PyByteArray_FromStringAndSize(NULL, 0);
+
+    append_key(key, &info->attachmentCount, sizeof(uint32_t));
+    append_key(key, info->pAttachments, sizeof(VkAttachmentDescription) * info->attachmentCount);
+
+    append_key(key, &info->subpassCount, sizeof(uint32_t));
+    for (uint32_t i = 0; i < info->subpassCount; ++i) {
+        const VkSubpassDescription * subpass = &info->pSubpasses[i];
+        uint32_t resolve_count = subpass->pResolveAttachments ? subpass->colorAttachmentCount : 0;
+        uint32_t depth_count = subpass->pDepthStencilAttachment ? 1 : 0;
+        append_attachment_references(key, subpass->inputAttachmentCount, subpass->pInputAttachments);
+        append_attachment_references(key, subpass->colorAttachmentCount, subpass->pColorAttachments);
+        append_attachment_references(key, resolve_count, subpass->pResolveAttachments);
+        append_attachment_references(key, depth_count, subpass->pDepthStencilAttachment);
+        append_key(key, &subpass->preserveAttachmentCount, sizeof(uint32_t));
+        append_key(key, subpass->pPreserveAttachments, sizeof(uint32_t) * subpass->preserveAttachmentCount);
+    }
+
+    append_key(key, &info->dependencyCount, sizeof(uint32_t));
+    append_key(key, info->pDependencies, sizeof(VkSubpassDependency) * info->dependencyCount);
+
+    uint32_t view_mask = 0;
+    const VkRenderPassMultiviewCreateInfo * multiview = (const VkRenderPassMultiviewCreateInfo *)info->pNext;
+    if (multiview && multiview->sType == VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO) {
+        view_mask = multiview->pViewMasks[0];
+    }
+    append_key(key, &view_mask, sizeof(uint32_t));
+
+    key = finish_key(key);
+
+    PyObject * cached = PyDict_GetItem(self->render_pass_dict, key);
+    if (cached) {
+        Py_DECREF(key);
+        return (VkRenderPass)PyLong_AsVoidPtr(cached);
+    }
+
+    VkRenderPass render_pass = NULL;
+    self->vkCreateRenderPass(self->device, info, NULL, &render_pass);
+
+    PyObject * ptr = PyLong_FromVoidPtr(render_pass);
+    PyDict_SetItem(self->render_pass_dict, key, ptr);
+    Py_DECREF(ptr);
+    Py_DECREF(key);
+    return render_pass;
+}
+
 Framebuffer * Task_meth_framebuffer(Task * self, PyObject * vargs, PyObject * kwargs) {
     Framebuffer * res = new_framebuffer(self->instance, vargs, kwargs);
     if (!res) {
@@ -326,19 +702,177 @@ Framebuffer * Task_meth_framebuffer(Task * self, PyObject * vargs, PyObject * kw
     return res;
 }
 
-void execute_framebuffer(Framebuffer * self, VkCommandBuffer command_buffer) {
-    for (uint32_t layer = 0; layer < self->layers; ++layer) {
-        VkRenderPassBeginInfo render_pass_begin_info = {
-            VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+int compare_render_pipelines(const void * a, const void * b) {
+    RenderPipeline * lhs = *(RenderPipeline **)a;
+    RenderPipeline * rhs = *(RenderPipeline **)b;
+
+    const void * lhs_key[] = {
+        lhs->pipeline,
+        lhs->descriptor_set,
+        lhs->attribute_count ? lhs->attribute_buffer_array[0] : NULL,
+        lhs->index_buffer ? lhs->index_buffer->buffer : NULL,
+    };
+
+    const void * rhs_key[] = {
+        rhs->pipeline,
+        rhs->descriptor_set,
+        rhs->attribute_count ? rhs->attribute_buffer_array[0] : NULL,
+        rhs->index_buffer ? rhs->index_buffer->buffer : NULL,
+    };
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (lhs_key[i] != rhs_key[i]) {
+            return lhs_key[i] < rhs_key[i] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+void transition_attachments(Framebuffer * self, VkCommandBuffer command_buffer, uint32_t layer, bool begin) {
+    VkImageMemoryBarrier image_barrier_array[64];
+    uint32_t image_barrier_count = 0;
+
+    for (uint32_t i = 0; i < self->attachment_count; ++i) {
+        VkImageLayout attachment_layout = self->reference_array[i].layout;
+        VkImageLayout old_layout = begin ? self->description_array[i].initialLayout : attachment_layout;
+        VkImageLayout new_layout = begin ? attachment_layout : self->description_array[i].finalLayout;
+
+        if (old_layout == new_layout) {
+            continue;
+        }
+
+        image_barrier_array[image_barrier_count++] = {
+            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
             NULL,
-            self->render_pass,
-            self->framebuffer_array[layer],
-            {{0, 0}, {self->width, self->height}},
-            self->attachment_count,
-            self->clear_value_array,
+            VK_ACCESS_MEMORY_WRITE_BIT,
+            VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+            old_layout,
+            new_layout,
+            VK_QUEUE_FAMILY_IGNORED,
+            VK_QUEUE_FAMILY_IGNORED,
+            self->image_array[i]->image,
+            {self->image_array[i]->aspect, 0, 1, self->multiview ? 0 : layer, self->multiview ? self->layers : 1},
         };
+    }
+
+    if (!image_barrier_count) {
+        return;
+    }
+
+    self->instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        0,
+        NULL,
+        0,
+        NULL,
+        image_barrier_count,
+        image_barrier_array
+    );
+}
+
+void begin_rendering(Framebuffer * self, VkCommandBuffer command_buffer, uint32_t layer) {
+    transition_attachments(self, command_buffer, layer, true);
+
+    VkImageView * image_view_array = self->image_view_array + self->attachment_count * layer;
+    VkRenderingAttachmentInfoKHR color_attachment_array[64];
+
+    for (uint32_t i = 0; i < self->output_count; ++i) {
+        uint32_t attachment = self->samples > 1 ? self->attachment_count - self->output_count + i : i;
+        color_attachment_array[i] = {
+            VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+            NULL,
+            image_view_array[attachment],
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            self->samples > 1 ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE,
+            self->samples > 1 ? image_view_array[i] : NULL,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            self->description_array[attachment].loadOp,
+            self->description_array[attachment].storeOp,
+            self->clear_value_array[attachment],
+        };
+    }
+
+    VkRenderingAttachmentInfoKHR depth_attachment = {
+        VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+        NULL,
+        self->depth ? image_view_array[self->output_count] : NULL,
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        VK_RESOLVE_MODE_NONE,
+        NULL,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        self->depth ? self->description_array[self->output_count].loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+        self->depth ? self->description_array[self->output_count].storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        self->depth ? self->clear_value_array[self->output_count] : VkClearValue{},
+    };
 
-        self->instance->vkCmdBeginRenderPass(command_buffer, &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
+    VkRenderingInfoKHR rendering_info = {
+        VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+        NULL,
+        0,
+        {{0, 0}, {self->width, self->height}},
+        1,
+        self->multiview ? get_view_mask(self->layers) : 0,
+        self->output_count,
+        color_attachment_array,
+        self->depth ? &depth_attachment : NULL,
+        NULL,
+    };
+
+    self->instance->vkCmdBeginRenderingKHR(command_buffer, &rendering_info);
+}
+
+void end_rendering(Framebuffer * self, VkCommandBuffer command_buffer, uint32_t layer) {
+    self->instance->vkCmdEndRenderingKHR(command_buffer);
+    transition_attachments(self, command_buffer, layer, false);
+}
+
+void execute_framebuffer(Framebuffer * self, VkCommandBuffer command_buffer) {
+    uint32_t pipeline_count = (uint32_t)PyList_GET_SIZE(self->render_pipeline_list);
+    RenderPipeline ** pipeline_array = (RenderPipeline **)PySequence_Fast_ITEMS(self->render_pipeline_list);
+
+    if (self->sort) {
+        pipeline_array = allocate<RenderPipeline *>(pipeline_count);
+        memcpy(pipeline_array, PySequence_Fast_ITEMS(self->render_pipeline_list), sizeof(RenderPipeline *) * pipeline_count);
+        qsort(pipeline_array, pipeline_count, sizeof(RenderPipeline *), compare_render_pipelines);
+    }
+
+    bool conditional = false;
+
+    for (uint32_t i = 0; i < PyList_GET_SIZE(self->render_pipeline_list); ++i) {
+        RenderPipeline * pipeline = (RenderPipeline *)PyList_GET_ITEM(self->render_pipeline_list, i);
+        if (pipeline->culling_kernel && pipeline->parameters.enabled) {
+            execute_culling(pipeline, command_buffer);
+        }
+        if (pipeline->condition_buffer && pipeline->parameters.enabled) {
+            conditional = true;
+        }
+    }
+
+    // Predicates written earlier in the task must be visible before the render pass begins.
+    if (conditional) {
+        condition_barrier(self->instance, command_buffer);
+    }
+
+    for (uint32_t layer = 0; layer < self->framebuffer_count; ++layer) {
+        if (self->dynamic) {
+            begin_rendering(self, command_buffer, layer);
+        } else {
+            VkRenderPassBeginInfo render_pass_begin_info = {
+                VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+                NULL,
+                self->render_pass,
+                self->framebuffer_array[layer],
+                {{0, 0}, {self->width, self->height}},
+                self->attachment_count,
+                self->clear_value_array,
+            };
+
+            self->instance->vkCmdBeginRenderPass(command_buffer, &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
+        }
 
         VkViewport viewport = {0.0f, 0.0f, (float)self->width, (float)self->height, 0.0f, 1.0f};
         self->instance->vkCmdSetViewport(command_buffer, 0, 1, &viewport);
@@ -346,26 +880,33 @@ void execute_framebuffer(Framebuffer * self, VkCommandBuffer command_buffer) {
         VkRect2D scissor = {{0, 0}, {self->width, self->height}};
         self->instance->vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
-        for (uint32_t i = 0; i < PyList_GET_SIZE(self->render_pipeline_list); ++i) {
-            RenderPipeline * pipeline = (RenderPipeline *)PyList_GET_ITEM(self->render_pipeline_list, i);
+        for (uint32_t subpass = 0; subpass < self->subpass_count; ++subpass) {
+            if (subpass) {
+                self->instance->vkCmdNextSubpass(command_buffer, VK_SUBPASS_CONTENTS_INLINE);
+            }
 
-            self->instance->vkCmdPushConstants(
-                command_buffer,
-                pipeline->pipeline_layout,
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                0,
-                4,
-                &layer
-            );
+            RenderState state = {layer};
 
-            execute_render_pipeline(pipeline, command_buffer);
+            for (uint32_t i = 0; i < pipeline_count; ++i) {
+                if (pipeline_array[i]->subpass == subpass) {
+                    execute_render_pipeline(pipeline_array[i], command_buffer, &state);
+                }
+            }
         }
 
-        self->instance->vkCmdEndRenderPass(command_buffer);
+        if (self->dynamic) {
+            end_rendering(self, command_buffer, layer);
+        } else {
+            self->instance->vkCmdEndRenderPass(command_buffer);
+        }
+
+        ComputeState compute_state = {};
+        compute_state.pending_stage = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
+        compute_state.pending_access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
 
         for (uint32_t i = 0; i < PyList_GET_SIZE(self->compute_pipeline_list); ++i) {
             ComputePipeline * pipeline = (ComputePipeline *)PyList_GET_ITEM(self->compute_pipeline_list, i);
-            execute_compute_pipeline(pipeline, command_buffer);
+            execute_compute_pipeline(pipeline, command_buffer, &compute_state);
         }
 
         if (self->image_barrier_count) {
@@ -425,6 +966,10 @@ void execute_framebuffer(Framebuffer * self, VkCommandBuffer command_buffer) {
             self->image_array,
         });
     }
+
+    if (self->sort) {
+        PyMem_Free(pipeline_array);
+    }
 }
 
 PyObject * Framebuffer_meth_update(Framebuffer * self, PyObject * vargs, PyObject * kwargs) {
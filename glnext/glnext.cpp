@@ -10,11 +10,15 @@
 #include "image.cpp"
 #include "info.cpp"
 #include "instance.cpp"
+#include "kernels.cpp"
 #include "loader.cpp"
+#include "primitives.cpp"
 #include "render_pipeline.cpp"
 #include "surface.cpp"
 #include "task.cpp"
+#include "texture.cpp"
 #include "tools.cpp"
+#include "tuning.cpp"
 #include "utils.cpp"
 
 PyMethodDef module_methods[] = {
@@ -29,9 +33,12 @@ PyMethodDef module_methods[] = {
 PyMethodDef Instance_methods[] = {
     {"buffer", (PyCFunction)Instance_meth_buffer, METH_VARARGS | METH_KEYWORDS, NULL},
     {"image", (PyCFunction)Instance_meth_image, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"load_texture", (PyCFunction)Instance_meth_load_texture, METH_VARARGS | METH_KEYWORDS, NULL},
     {"surface", (PyCFunction)Instance_meth_surface, METH_VARARGS | METH_KEYWORDS, NULL},
     {"task", (PyCFunction)Instance_meth_task, METH_NOARGS, NULL},
     {"cache", (PyCFunction)Instance_meth_cache, METH_NOARGS, NULL},
+    {"save_cache", (PyCFunction)Instance_meth_save_cache, METH_NOARGS, NULL},
+    {"compile", (PyCFunction)Instance_meth_compile, METH_NOARGS, NULL},
     {"present", (PyCFunction)Instance_meth_present, METH_NOARGS, NULL},
     {"group", (PyCFunction)Instance_meth_group, METH_VARARGS | METH_KEYWORDS, NULL},
     {},
@@ -40,6 +47,11 @@ PyMethodDef Instance_methods[] = {
 PyMethodDef Task_methods[] = {
     {"framebuffer", (PyCFunction)Task_meth_framebuffer, METH_VARARGS | METH_KEYWORDS, NULL},
     {"compute", (PyCFunction)Task_meth_compute, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"scan", (PyCFunction)Task_meth_scan, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"reduce", (PyCFunction)Task_meth_reduce, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"compact", (PyCFunction)Task_meth_compact, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"sort", (PyCFunction)Task_meth_sort, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"autotune", (PyCFunction)Task_meth_autotune, METH_VARARGS | METH_KEYWORDS, NULL},
     {"run", (PyCFunction)Task_meth_run, METH_NOARGS, NULL},
     {},
 };
@@ -64,11 +76,12 @@ PyMethodDef ComputePipeline_methods[] = {
 PyMethodDef Buffer_methods[] = {
     {"read", (PyCFunction)Buffer_meth_read, METH_NOARGS, NULL},
     {"write", (PyCFunction)Buffer_meth_write, METH_O, NULL},
+    {"write_file", (PyCFunction)Buffer_meth_write_file, METH_VARARGS | METH_KEYWORDS, NULL},
     {},
 };
 
 PyMethodDef Image_methods[] = {
-    {"read", (PyCFunction)Image_meth_read, METH_NOARGS, NULL},
+    {"read", (PyCFunction)Image_meth_read, METH_VARARGS | METH_KEYWORDS, NULL},
     {"write", (PyCFunction)Image_meth_write, METH_O, NULL},
     {},
 };
@@ -89,6 +102,11 @@ PyGetSetDef Framebuffer_getset[] = {
     {},
 };
 
+PyGetSetDef Instance_getset[] = {
+    {"stats", (getter)Instance_get_stats, NULL, NULL, NULL},
+    {},
+};
+
 PyGetSetDef Buffer_getset[] = {
     {"size", (getter)Buffer_get_size, NULL, NULL, NULL},
     {},
@@ -101,6 +119,9 @@ PyGetSetDef Image_getset[] = {
 
 PyMemberDef Instance_members[] = {
     {"log", T_OBJECT_EX, offsetof(Instance, log_list), READONLY, NULL},
+    {"limits", T_OBJECT_EX, offsetof(Instance, limits), READONLY, NULL},
+    {"features", T_OBJECT_EX, offsetof(Instance, features), READONLY, NULL},
+    {"__weaklistoffset__", T_PYSSIZET, offsetof(Instance, weakreflist), READONLY, NULL},
     {},
 };
 
@@ -121,7 +142,8 @@ void default_dealloc(PyObject * self) {
 PyType_Slot Instance_slots[] = {
     {Py_tp_methods, Instance_methods},
     {Py_tp_members, Instance_members},
-    {Py_tp_dealloc, default_dealloc},
+    {Py_tp_getset, Instance_getset},
+    {Py_tp_dealloc, Instance_dealloc},
     {},
 };
 
@@ -227,6 +249,8 @@ int module_exec(PyObject * self) {
     state->default_topology = PyUnicode_FromString("triangles");
     state->default_front_face = PyUnicode_FromString("counter_clockwise");
     state->default_format = PyUnicode_FromString("4p");
+    state->default_primitive_format = PyUnicode_FromString("I");
+    state->default_primitive_op = PyUnicode_FromString("add");
     state->one_float_str = PyUnicode_FromString("1f");
     state->one_int_str = PyUnicode_FromString("1i");
     state->texture_str = PyUnicode_FromString("texture");
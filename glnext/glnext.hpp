@@ -3,6 +3,10 @@
 #include <Python.h>
 #include <structmember.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include <vulkan/vulkan_core.h>
 
 #ifdef BUILD_WINDOWS
@@ -14,6 +18,10 @@
 
 #ifdef BUILD_LINUX
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <X11/Xlib.h>
 #include <vulkan/vulkan_xlib.h>
 #define DEFAULT_SURFACE "VK_KHR_xlib_surface"
@@ -21,6 +29,10 @@
 #endif
 
 #ifdef BUILD_DARWIN
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <QuartzCore/CAMetalLayer.h>
 #include <vulkan/vulkan_metal.h>
 #define DEFAULT_SURFACE "VK_EXT_metal_surface"
@@ -33,6 +45,89 @@ typedef VkResult (VKAPI_PTR * PFN_vkCreateXcbSurfaceKHR)(VkInstance, const struc
 typedef VkResult (VKAPI_PTR * PFN_vkCreateWaylandSurfaceKHR)(VkInstance, const struct VkWaylandSurfaceCreateInfoKHR *, const VkAllocationCallbacks *, VkSurfaceKHR *);
 typedef VkResult (VKAPI_PTR * PFN_vkCreateMetalSurfaceEXT)(VkInstance, const struct VkMetalSurfaceCreateInfoEXT *, const VkAllocationCallbacks *, VkSurfaceKHR *);
 
+#ifndef VK_EXT_graphics_pipeline_library
+#define VK_EXT_graphics_pipeline_library 1
+#define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT ((VkStructureType)1000320000)
+#define VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT ((VkStructureType)1000320002)
+#define VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT 0x00000001
+#define VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT 0x00000002
+#define VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT 0x00000004
+#define VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT 0x00000008
+
+typedef VkFlags VkGraphicsPipelineLibraryFlagsEXT;
+
+struct VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT {
+    VkStructureType sType;
+    void * pNext;
+    VkBool32 graphicsPipelineLibrary;
+};
+
+struct VkGraphicsPipelineLibraryCreateInfoEXT {
+    VkStructureType sType;
+    void * pNext;
+    VkGraphicsPipelineLibraryFlagsEXT flags;
+};
+#endif
+
+#ifndef VK_API_VERSION_1_3
+#define VK_API_VERSION_1_3 VK_MAKE_VERSION(1, 3, 0)
+#endif
+
+#ifndef VK_KHR_dynamic_rendering
+#define VK_KHR_dynamic_rendering 1
+#define VK_STRUCTURE_TYPE_RENDERING_INFO_KHR ((VkStructureType)1000044000)
+#define VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR ((VkStructureType)1000044001)
+#define VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR ((VkStructureType)1000044002)
+#define VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR ((VkStructureType)1000044003)
+
+typedef VkFlags VkRenderingFlagsKHR;
+
+struct VkRenderingAttachmentInfoKHR {
+    VkStructureType sType;
+    const void * pNext;
+    VkImageView imageView;
+    VkImageLayout imageLayout;
+    VkResolveModeFlagBits resolveMode;
+    VkImageView resolveImageView;
+    VkImageLayout resolveImageLayout;
+    VkAttachmentLoadOp loadOp;
+    VkAttachmentStoreOp storeOp;
+    VkClearValue clearValue;
+};
+
+struct VkRenderingInfoKHR {
+    VkStructureType sType;
+    const void * pNext;
+    VkRenderingFlagsKHR flags;
+    VkRect2D renderArea;
+    uint32_t layerCount;
+    uint32_t viewMask;
+    uint32_t colorAttachmentCount;
+    const VkRenderingAttachmentInfoKHR * pColorAttachments;
+    const VkRenderingAttachmentInfoKHR * pDepthAttachment;
+    const VkRenderingAttachmentInfoKHR * pStencilAttachment;
+};
+
+struct VkPipelineRenderingCreateInfoKHR {
+    VkStructureType sType;
+    const void * pNext;
+    uint32_t viewMask;
+    uint32_t colorAttachmentCount;
+    const VkFormat * pColorAttachmentFormats;
+    VkFormat depthAttachmentFormat;
+    VkFormat stencilAttachmentFormat;
+};
+
+struct VkPhysicalDeviceDynamicRenderingFeaturesKHR {
+    VkStructureType sType;
+    void * pNext;
+    VkBool32 dynamicRendering;
+};
+
+typedef void (VKAPI_PTR * PFN_vkCmdBeginRenderingKHR)(VkCommandBuffer, const VkRenderingInfoKHR *);
+typedef void (VKAPI_PTR * PFN_vkCmdEndRenderingKHR)(VkCommandBuffer);
+#endif
+
 enum ImageMode {
     IMG_PROTECTED,
     IMG_TEXTURE,
@@ -40,6 +135,15 @@ enum ImageMode {
     IMG_STORAGE,
 };
 
+enum MipmapFilter {
+    MIP_BOX,
+    MIP_KAISER,
+    MIP_MIN,
+    MIP_MAX,
+    MIP_NONE,
+    MIP_INVALID,
+};
+
 enum BufferMode {
     BUF_UNIFORM,
     BUF_STORAGE,
@@ -100,6 +204,110 @@ struct HostBuffer {
     void * ptr;
 };
 
+struct ResourceAccess {
+    PyObject * resource;
+    VkPipelineStageFlags stage;
+    VkAccessFlags access;
+    VkBool32 write;
+};
+
+struct ComputeState {
+    VkPipelineStageFlags pending_stage;
+    VkAccessFlags pending_access;
+    uint32_t access_count;
+    ResourceAccess access_array[64];
+};
+
+struct RenderState {
+    uint32_t layer;
+    VkPipeline pipeline;
+    VkPipelineLayout pipeline_layout;
+    VkDescriptorSet descriptor_set;
+    VkBuffer index_buffer;
+    VkDeviceSize index_buffer_offset;
+    VkIndexType index_type;
+    uint32_t attribute_count;
+    VkBuffer * attribute_buffer_array;
+    VkDeviceSize * attribute_offset_array;
+};
+
+struct SpecializationState {
+    VkSpecializationInfo info;
+    VkSpecializationMapEntry entry_array[64];
+    uint32_t data[64];
+};
+
+struct GraphicsPipelineState {
+    SpecializationState specialization;
+    uint32_t shader_stage_count;
+    VkPipelineShaderStageCreateInfo shader_stage_array[8];
+    VkVertexInputBindingDescription binding_array[64];
+    VkVertexInputAttributeDescription attribute_array[64];
+    VkPipelineColorBlendAttachmentState color_blend_attachment_array[64];
+    VkDynamicState dynamic_state_array[2];
+    VkPipelineVertexInputStateCreateInfo vertex_input_state;
+    VkPipelineInputAssemblyStateCreateInfo input_assembly_state;
+    VkPipelineViewportStateCreateInfo viewport_state;
+    VkPipelineRasterizationStateCreateInfo rasterization_state;
+    VkPipelineMultisampleStateCreateInfo multisample_state;
+    VkPipelineDepthStencilStateCreateInfo depth_stencil_state;
+    VkPipelineColorBlendStateCreateInfo color_blend_state;
+    VkPipelineDynamicStateCreateInfo dynamic_state;
+    VkFormat color_format_array[64];
+    VkPipelineRenderingCreateInfoKHR rendering;
+    VkGraphicsPipelineCreateInfo pipeline_create_info;
+};
+
+struct PipelineLibraryState {
+    VkGraphicsPipelineLibraryCreateInfoEXT library_create_info;
+    VkGraphicsPipelineCreateInfo pipeline_create_info;
+    VkPipelineShaderStageCreateInfo shader_stage_array[8];
+};
+
+struct ComputePipelineState {
+    SpecializationState specialization;
+    VkComputePipelineCreateInfo pipeline_create_info;
+};
+
+struct PipelineLayout {
+    VkDescriptorSetLayout descriptor_set_layout;
+    VkPipelineLayout pipeline_layout;
+};
+
+struct Kernel {
+    VkDescriptorSetLayout descriptor_set_layout;
+    VkPipelineLayout pipeline_layout;
+    VkPipeline pipeline;
+};
+
+struct KernelCode {
+    const uint32_t * words;
+    size_t size;
+};
+
+struct KernelInfo {
+    const char * name;
+    const KernelCode * code;
+    uint32_t binding_count;
+    const VkDescriptorType * binding_type_array;
+    uint32_t push_constant_size;
+};
+
+struct PrimitiveInfo {
+    const char * name;
+    const KernelCode * subgroup_code;
+    const KernelCode * code;
+};
+
+struct MappedFile {
+    void * ptr;
+    size_t size;
+    #ifdef BUILD_WINDOWS
+    HANDLE file;
+    HANDLE mapping;
+    #endif
+};
+
 struct SwapChainImages {
     uint32_t image_count;
     VkImage image_array[8];
@@ -123,6 +331,8 @@ struct ModuleState {
     PyObject * default_topology;
     PyObject * default_front_face;
     PyObject * default_format;
+    PyObject * default_primitive_format;
+    PyObject * default_primitive_op;
     PyObject * one_float_str;
     PyObject * one_int_str;
     PyObject * texture_str;
@@ -133,11 +343,16 @@ struct Extension {
     VkBool32 acceleration_structure;
     VkBool32 dedicated_allocation;
     VkBool32 deferred_host_operations;
+    VkBool32 conditional_rendering;
     VkBool32 draw_indirect_count;
+    VkBool32 dynamic_rendering;
+    VkBool32 graphics_pipeline_library;
     VkBool32 mesh_shader;
+    VkBool32 multiview;
     VkBool32 pipeline_library;
     VkBool32 ray_query;
     VkBool32 ray_tracing_pipeline;
+    VkBool32 shader_float16_int8;
 };
 
 struct Instance {
@@ -154,8 +369,15 @@ struct Instance {
 
     VkPipelineCache pipeline_cache;
     VkDebugUtilsMessengerEXT debug_messenger;
+    VkPhysicalDeviceProperties physical_device_properties;
+    uint32_t max_multiview_view_count;
+    VkPhysicalDeviceSubgroupProperties subgroup_properties;
+    uint32_t timestamp_valid_bits;
+    VkPhysicalDeviceFeatures physical_device_features;
+    VkSampler kernel_sampler;
 
     VkBool32 debug;
+    VkBool32 deferred;
     uint32_t api_version;
     uint32_t queue_family_index;
     uint32_t host_memory_type_index;
@@ -164,6 +386,7 @@ struct Instance {
 
     Extension extension;
     Group * group;
+    uint64_t group_index;
 
     PyObject * surface_list;
     PyObject * task_list;
@@ -171,6 +394,19 @@ struct Instance {
     PyObject * buffer_list;
     PyObject * image_list;
     PyObject * log_list;
+    PyObject * limits;
+    PyObject * features;
+    PyObject * kernel_dict;
+    PyObject * primitive_dict;
+    PyObject * tuning_dict;
+    PyObject * cache_path;
+    PyObject * pending_list;
+    PyObject * shader_module_dict;
+    PyObject * pipeline_layout_dict;
+    PyObject * render_pass_dict;
+    PyObject * pipeline_dict;
+    PyObject * library_dict;
+    PyObject * weakreflist;
 
     ModuleState * state;
 
@@ -184,6 +420,7 @@ struct Instance {
     PFN_vkEnumerateDeviceExtensionProperties vkEnumerateDeviceExtensionProperties;
     PFN_vkGetPhysicalDeviceProperties vkGetPhysicalDeviceProperties;
     PFN_vkGetPhysicalDeviceFeatures2 vkGetPhysicalDeviceFeatures2;
+    PFN_vkGetPhysicalDeviceProperties2 vkGetPhysicalDeviceProperties2;
     PFN_vkGetPhysicalDeviceMemoryProperties vkGetPhysicalDeviceMemoryProperties;
     PFN_vkGetPhysicalDeviceFeatures vkGetPhysicalDeviceFeatures;
     PFN_vkGetPhysicalDeviceFormatProperties vkGetPhysicalDeviceFormatProperties;
@@ -192,8 +429,10 @@ struct Instance {
     PFN_vkCreateDevice vkCreateDevice;
     PFN_vkGetDeviceQueue vkGetDeviceQueue;
     PFN_vkCreateFence vkCreateFence;
+    PFN_vkDestroyFence vkDestroyFence;
     PFN_vkCreateCommandPool vkCreateCommandPool;
     PFN_vkAllocateCommandBuffers vkAllocateCommandBuffers;
+    PFN_vkFreeCommandBuffers vkFreeCommandBuffers;
     PFN_vkGetImageMemoryRequirements vkGetImageMemoryRequirements;
     PFN_vkCmdCopyImageToBuffer vkCmdCopyImageToBuffer;
     PFN_vkCreateShaderModule vkCreateShaderModule;
@@ -201,12 +440,20 @@ struct Instance {
     PFN_vkCmdCopyBufferToImage vkCmdCopyBufferToImage;
     PFN_vkCreateImageView vkCreateImageView;
     PFN_vkCmdDispatch vkCmdDispatch;
+    PFN_vkCmdDispatchIndirect vkCmdDispatchIndirect;
+    PFN_vkCreateQueryPool vkCreateQueryPool;
+    PFN_vkDestroyQueryPool vkDestroyQueryPool;
+    PFN_vkCmdResetQueryPool vkCmdResetQueryPool;
+    PFN_vkCmdWriteTimestamp vkCmdWriteTimestamp;
+    PFN_vkGetQueryPoolResults vkGetQueryPoolResults;
     PFN_vkCmdBindIndexBuffer vkCmdBindIndexBuffer;
     PFN_vkBindImageMemory vkBindImageMemory;
     PFN_vkFreeMemory vkFreeMemory;
     PFN_vkCmdSetViewport vkCmdSetViewport;
     PFN_vkCmdBindDescriptorSets vkCmdBindDescriptorSets;
     PFN_vkCmdCopyBuffer vkCmdCopyBuffer;
+    PFN_vkCmdFillBuffer vkCmdFillBuffer;
+    PFN_vkCmdUpdateBuffer vkCmdUpdateBuffer;
     PFN_vkCmdPushConstants vkCmdPushConstants;
     PFN_vkUnmapMemory vkUnmapMemory;
     PFN_vkEndCommandBuffer vkEndCommandBuffer;
@@ -220,16 +467,23 @@ struct Instance {
     PFN_vkCreatePipelineLayout vkCreatePipelineLayout;
     PFN_vkCreatePipelineCache vkCreatePipelineCache;
     PFN_vkGetPipelineCacheData vkGetPipelineCacheData;
+    PFN_vkMergePipelineCaches vkMergePipelineCaches;
+    PFN_vkDestroyPipelineCache vkDestroyPipelineCache;
     PFN_vkCmdSetScissor vkCmdSetScissor;
     PFN_vkCmdBindPipeline vkCmdBindPipeline;
     PFN_vkCreateGraphicsPipelines vkCreateGraphicsPipelines;
     PFN_vkCreateDescriptorSetLayout vkCreateDescriptorSetLayout;
     PFN_vkCmdEndRenderPass vkCmdEndRenderPass;
+    PFN_vkCmdNextSubpass vkCmdNextSubpass;
+    PFN_vkCmdBeginConditionalRenderingEXT vkCmdBeginConditionalRenderingEXT;
+    PFN_vkCmdEndConditionalRenderingEXT vkCmdEndConditionalRenderingEXT;
     PFN_vkCmdExecuteCommands vkCmdExecuteCommands;
     PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier;
     PFN_vkCreateDescriptorPool vkCreateDescriptorPool;
     PFN_vkCreateImage vkCreateImage;
     PFN_vkCmdBeginRenderPass vkCmdBeginRenderPass;
+    PFN_vkCmdBeginRenderingKHR vkCmdBeginRenderingKHR;
+    PFN_vkCmdEndRenderingKHR vkCmdEndRenderingKHR;
     PFN_vkCreateComputePipelines vkCreateComputePipelines;
     PFN_vkBeginCommandBuffer vkBeginCommandBuffer;
     PFN_vkCreateFramebuffer vkCreateFramebuffer;
@@ -302,6 +556,12 @@ struct DescriptorBinding {
         VkBufferUsageFlags usage;
         VkDescriptorBufferInfo descriptor_buffer_info;
         BufferMode mode;
+        VkBool32 dynamic;
+        VkDeviceSize stride;
+        uint32_t slot_count;
+        uint32_t slot;
+        uint64_t group_index;
+        uint32_t group_writes;
     } buffer;
     struct {
         VkBool32 sampled;
@@ -329,6 +589,12 @@ struct Framebuffer {
     uint32_t layers;
     VkBool32 depth;
     VkBool32 compute;
+    VkBool32 sort;
+    VkBool32 multiview;
+    VkBool32 dynamic;
+    uint32_t framebuffer_count;
+    uint32_t subpass_count;
+    uint32_t subpass_output_count_array[16];
     ImageMode mode;
     Image ** image_array;
     VkImageView * image_view_array;
@@ -349,6 +615,7 @@ struct Framebuffer {
 struct RenderPipeline {
     PyObject_HEAD
     Instance * instance;
+    uint32_t subpass;
     RenderParameters parameters;
     RenderCommand render_command;
     Buffer * vertex_buffer;
@@ -356,6 +623,8 @@ struct RenderPipeline {
     Buffer * index_buffer;
     Buffer * indirect_buffer;
     Buffer * count_buffer;
+    Buffer * condition_buffer;
+    VkDeviceSize condition_offset;
     uint32_t binding_count;
     DescriptorBinding * binding_array;
     VkDescriptorSetLayoutBinding * descriptor_binding_array;
@@ -365,11 +634,22 @@ struct RenderPipeline {
     VkPipelineLayout pipeline_layout;
     VkDescriptorPool descriptor_pool;
     VkDescriptorSet descriptor_set;
+    uint32_t push_constant_size;
+    char * push_constant_data;
+    uint32_t * dynamic_offset_array;
     VkIndexType index_type;
     uint32_t attribute_count;
     VkBuffer * attribute_buffer_array;
     VkDeviceSize * attribute_offset_array;
+    GraphicsPipelineState * pipeline_state;
     VkPipeline pipeline;
+    Kernel * culling_kernel;
+    VkDescriptorPool culling_descriptor_pool;
+    VkDescriptorSet culling_descriptor_set;
+    Buffer * bounds_buffer;
+    Buffer * visible_buffer;
+    uint32_t instance_stride;
+    float camera[16];
     PyObject * members;
 };
 
@@ -386,6 +666,16 @@ struct ComputePipeline {
     VkPipelineLayout pipeline_layout;
     VkDescriptorPool descriptor_pool;
     VkDescriptorSet descriptor_set;
+    uint32_t push_constant_size;
+    char * push_constant_data;
+    uint32_t * dynamic_offset_array;
+    Buffer * condition_buffer;
+    VkDeviceSize condition_offset;
+    Buffer * indirect_buffer;
+    VkDeviceSize indirect_offset;
+    uint32_t access_count;
+    ResourceAccess * access_array;
+    ComputePipelineState * pipeline_state;
     VkPipeline pipeline;
     PyObject * members;
 };
@@ -439,6 +729,16 @@ struct Image {
     VkFormat format;
     VkImage image;
     VkBool32 bound;
+    VkImageView read_image_view;
+    VkDescriptorPool read_descriptor_pool;
+    VkDescriptorSet read_descriptor_set;
+    VkBuffer read_buffer;
+    MipmapFilter filter;
+    VkFormat mipmap_format;
+    VkImageView mipmap_image_view_array[13];
+    VkDescriptorPool mipmap_descriptor_pool;
+    VkDescriptorSet mipmap_descriptor_set;
+    Buffer * mipmap_buffer;
 };
 
 struct Group {
@@ -468,6 +768,7 @@ struct ImageCreateInfo {
     uint32_t layers;
     ImageMode mode;
     VkFormat format;
+    MipmapFilter filter;
 };
 
 struct BuildMipmapsInfo {
@@ -486,11 +787,29 @@ T * allocate(uint32_t count) {
     return (T *)PyMem_Malloc(sizeof(T) * count);
 }
 
+inline uint32_t get_view_mask(uint32_t layers) {
+    return layers >= 32 ? ~0u : (1u << layers) - 1;
+}
+
 inline bool has_key(PyObject * dict, const char * key) {
     return !!PyDict_GetItemString(dict, key);
 }
 
+inline void append_key(PyObject * key, const void * data, size_t size) {
+    Py_ssize_t offset = PyByteArray_Size(key);
+    PyByteArray_Resize(key, offset + size);
+    memcpy(PyByteArray_AsString(key) + offset, data, size);
+}
+
+inline PyObject * finish_key(PyObject * key) {
+    PyObject * res = PyBytes_FromObject(key);
+    Py_DECREF(key);
+    return res;
+}
+
+PyObject * Instance_meth_save_cache(Instance * self);
 PyObject * Buffer_meth_write(Buffer * self, PyObject * arg);
+PyObject * Buffer_meth_write_file(Buffer * self, PyObject * vargs, PyObject * kwargs);
 
 PFN_vkGetInstanceProcAddr get_instance_proc_addr(const char * backend);
 
@@ -511,16 +830,38 @@ void install_debug_messenger(Instance * instance);
 int parse_descriptor_binding(Instance * instance, DescriptorBinding * binding, PyObject * obj);
 void create_descriptor_binding_objects(Instance * instance, DescriptorBinding * binding, Memory * memory);
 void bind_descriptor_binding_objects(Instance * instance, DescriptorBinding * binding);
+int write_dynamic_binding(Instance * instance, uint32_t binding_count, DescriptorBinding * binding_array, PyObject * name, PyObject * value);
+uint32_t get_dynamic_offsets(uint32_t binding_count, DescriptorBinding * binding_array, uint32_t * offset_array);
+
+VkShaderModule get_shader_module(Instance * instance, PyObject * code);
+PipelineLayout * get_pipeline_layout(Instance * instance, uint32_t binding_count, VkDescriptorSetLayoutBinding * binding_array, VkPushConstantRange * push_constant_range);
+
+VkRenderPass get_render_pass(Instance * instance, VkRenderPassCreateInfo * render_pass_create_info);
+PyObject * get_pipeline_key(GraphicsPipelineState * state);
+VkPipeline create_graphics_pipeline(Instance * instance, GraphicsPipelineState * state);
+bool use_pipeline_library(Instance * instance, GraphicsPipelineState * state);
+PyObject * get_pipeline_library_key(GraphicsPipelineState * state, VkGraphicsPipelineLibraryFlagsEXT part);
+void fill_pipeline_library(PipelineLibraryState * library, GraphicsPipelineState * state, VkGraphicsPipelineLibraryFlagsEXT part);
+
+void release_pipeline_state(RenderPipeline * self);
+void release_pipeline_state(ComputePipeline * self);
+void compile_pipelines(Instance * instance);
 
 void execute_framebuffer(Framebuffer * self, VkCommandBuffer command_buffer);
-void execute_render_pipeline(RenderPipeline * self, VkCommandBuffer command_buffer);
-void execute_compute_pipeline(ComputePipeline * self, VkCommandBuffer command_buffer);
+void execute_render_pipeline(RenderPipeline * self, VkCommandBuffer command_buffer, RenderState * state);
+void execute_culling(RenderPipeline * self, VkCommandBuffer command_buffer);
+void execute_compute_pipeline(ComputePipeline * self, VkCommandBuffer command_buffer, ComputeState * state);
+void flush_compute_state(Instance * instance, VkCommandBuffer command_buffer, ComputeState * state);
 
 void begin_commands(Instance * instance);
 void end_commands(Instance * instance);
 
 Memory * new_memory(Instance * instance, VkBool32 host = false);
 Memory * get_memory(Instance * instance, PyObject * memory);
+Buffer * get_buffer(Instance * instance, PyObject * obj);
+bool check_condition_buffer(Instance * instance, Buffer * buffer, VkDeviceSize offset);
+void condition_barrier(Instance * instance, VkCommandBuffer command_buffer);
+void begin_conditional_rendering(Instance * instance, VkCommandBuffer command_buffer, Buffer * buffer, VkDeviceSize offset);
 
 VkDeviceSize take_memory(Memory * self, VkMemoryRequirements * requirements);
 
@@ -538,6 +879,36 @@ void free_temp_buffer(Instance * instance, HostBuffer * temp);
 
 void build_mipmaps(BuildMipmapsInfo args);
 
+bool map_file(MappedFile * mapped, const char * path);
+void unmap_file(MappedFile * mapped);
+bool write_file(const char * path, const void * data, size_t size);
+
+void merge_pipeline_cache_file(Instance * instance, const char * path);
+void merge_tuning_file(Instance * instance, const char * path);
+bool save_tuning_file(Instance * instance, const char * path);
+
+extern const KernelInfo read_kernel;
+extern const KernelInfo cull_kernel;
+extern const KernelInfo mipmap_kernel;
+
+extern const PrimitiveInfo reduce_primitive;
+extern const PrimitiveInfo partial_primitive;
+extern const PrimitiveInfo scan_primitive;
+extern const PrimitiveInfo compact_primitive;
+extern const PrimitiveInfo histogram_primitive;
+extern const PrimitiveInfo scatter_primitive;
+
+Kernel * get_kernel(Instance * instance, KernelInfo info);
+Kernel * get_mipmap_kernel(Instance * instance);
+PyObject * get_primitive_shader(Instance * instance, PrimitiveInfo info);
+VkSampler get_kernel_sampler(Instance * instance);
+void dispatch_kernel_words(Instance * instance, VkCommandBuffer command_buffer, uint32_t words);
+
+int parse_specialization(SpecializationState * specialization, PyObject * obj);
+
 VkPrimitiveTopology get_topology(PyObject * name);
 ImageMode get_image_mode(PyObject * name);
+MipmapFilter get_mipmap_filter(PyObject * name);
+VkAttachmentLoadOp get_load_op(PyObject * name);
+VkAttachmentStoreOp get_store_op(PyObject * name);
 Format get_format(PyObject * name);
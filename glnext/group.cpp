@@ -24,6 +24,7 @@ PyObject * Group_meth_enter(Group * self) {
     begin_commands(self->instance);
     PySequence_DelSlice(self->output, 0, PyList_Size(self->output));
     self->instance->group = self;
+    self->instance->group_index += 1;
     self->offset = 0;
     Py_INCREF(self);
     Py_RETURN_NONE;
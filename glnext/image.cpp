@@ -7,6 +7,7 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
         "levels",
         "layers",
         "mode",
+        "filter",
         "memory",
         NULL,
     };
@@ -18,6 +19,7 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
         uint32_t levels = 1;
         uint32_t layers = 1;
         PyObject * mode;
+        PyObject * filter = NULL;
         PyObject * memory = Py_None;
     } args;
 
@@ -27,7 +29,7 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
     int args_ok = PyArg_ParseTupleAndKeywords(
         vargs,
         kwargs,
-        "(II)|O$IIOO",
+        "(II)|O$IIOO!O",
         keywords,
         &args.width,
         &args.height,
@@ -35,6 +37,8 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
         &args.levels,
         &args.layers,
         &args.mode,
+        &PyUnicode_Type,
+        &args.filter,
         &args.memory
     );
 
@@ -51,6 +55,13 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
         return NULL;
     }
 
+    MipmapFilter filter = args.filter ? get_mipmap_filter(args.filter) : MIP_BOX;
+
+    if (filter == MIP_INVALID) {
+        PyErr_Format(PyExc_ValueError, "filter");
+        return NULL;
+    }
+
     VkImageUsageFlags image_usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     VkImageLayout image_layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
 
@@ -64,6 +75,10 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
         image_layout = VK_IMAGE_LAYOUT_GENERAL;
     }
 
+    if (image_mode == IMG_OUTPUT) {
+        image_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    }
+
     if (args.levels > 1) {
         image_usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     }
@@ -80,6 +95,7 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
         args.layers,
         image_mode,
         format.format,
+        filter,
     });
 
     allocate_memory(memory);
@@ -117,51 +133,339 @@ Image * Instance_meth_image(Instance * self, PyObject * vargs, PyObject * kwargs
     return res;
 }
 
-PyObject * Image_meth_read(Image * self) {
+bool parse_read_format(PyObject * format, uint32_t * components, uint32_t * type, uint32_t * item_size) {
+    const char * s = PyUnicode_AsUTF8(format);
+    if (!s || strlen(s) != 2 || s[0] < '1' || s[0] > '4') {
+        return false;
+    }
+
+    *components = s[0] - '0';
+
+    switch (s[1]) {
+        case 'p': *type = 0; *item_size = 1; return true;
+        case 's': *type = 1; *item_size = 1; return true;
+        case 'f': *type = 2; *item_size = 4; return true;
+        case 'h': *type = 3; *item_size = 2; return true;
+    }
+
+    return false;
+}
+
+bool is_integer_format(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_R32_SINT:
+        case VK_FORMAT_R32G32_SINT:
+        case VK_FORMAT_R32G32B32_SINT:
+        case VK_FORMAT_R32G32B32A32_SINT:
+        case VK_FORMAT_R32_UINT:
+        case VK_FORMAT_R32G32_UINT:
+        case VK_FORMAT_R32G32B32_UINT:
+        case VK_FORMAT_R32G32B32A32_UINT:
+        case VK_FORMAT_R8_UINT:
+        case VK_FORMAT_R8G8_UINT:
+        case VK_FORMAT_R8G8B8_UINT:
+        case VK_FORMAT_R8G8B8A8_UINT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void record_read_kernel(Image * self, Kernel * kernel, VkBuffer buffer, uint32_t * parameters) {
+    Instance * instance = self->instance;
+
+    if (!self->read_descriptor_set) {
+        VkImageViewCreateInfo image_view_create_info = {
+            VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            NULL,
+            0,
+            self->image,
+            VK_IMAGE_VIEW_TYPE_2D_ARRAY,
+            self->format,
+            {VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY},
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, self->layers},
+        };
+
+        instance->vkCreateImageView(instance->device, &image_view_create_info, NULL, &self->read_image_view);
+
+        VkDescriptorPoolSize descriptor_pool_size_array[] = {
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},
+        };
+
+        VkDescriptorPoolCreateInfo descriptor_pool_create_info = {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            NULL,
+            0,
+            1,
+            2,
+            descriptor_pool_size_array,
+        };
+
+        instance->vkCreateDescriptorPool(instance->device, &descriptor_pool_create_info, NULL, &self->read_descriptor_pool);
+
+        VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            NULL,
+            self->read_descriptor_pool,
+            1,
+            &kernel->descriptor_set_layout,
+        };
+
+        instance->vkAllocateDescriptorSets(instance->device, &descriptor_set_allocate_info, &self->read_descriptor_set);
+
+        VkDescriptorImageInfo descriptor_image_info = {
+            get_kernel_sampler(instance),
+            self->read_image_view,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        };
+
+        VkWriteDescriptorSet write_descriptor_set = {
+            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            NULL,
+            self->read_descriptor_set,
+            0,
+            0,
+            1,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            &descriptor_image_info,
+            NULL,
+            NULL,
+        };
+
+        instance->vkUpdateDescriptorSets(instance->device, 1, &write_descriptor_set, 0, NULL);
+    }
+
+    // Within a group every read targets the same staging buffer and the set may already be bound.
+    if (!instance->group || self->read_buffer != buffer) {
+        VkDescriptorBufferInfo descriptor_buffer_info = {buffer, 0, VK_WHOLE_SIZE};
+
+        VkWriteDescriptorSet write_descriptor_set = {
+            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            NULL,
+            self->read_descriptor_set,
+            1,
+            0,
+            1,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            NULL,
+            &descriptor_buffer_info,
+            NULL,
+        };
+
+        instance->vkUpdateDescriptorSets(instance->device, 1, &write_descriptor_set, 0, NULL);
+        self->read_buffer = instance->group ? buffer : NULL;
+    }
+
+    VkImageMemoryBarrier image_barrier = {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_TRANSFER_READ_BIT,
+        VK_ACCESS_SHADER_READ_BIT,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        self->image,
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, self->layers},
+    };
+
+    instance->vkCmdPipelineBarrier(
+        instance->command_buffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        0,
+        NULL,
+        0,
+        NULL,
+        1,
+        &image_barrier
+    );
+
+    instance->vkCmdBindPipeline(instance->command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, kernel->pipeline);
+
+    instance->vkCmdBindDescriptorSets(
+        instance->command_buffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        kernel->pipeline_layout,
+        0,
+        1,
+        &self->read_descriptor_set,
+        0,
+        NULL
+    );
+
+    instance->vkCmdPushConstants(
+        instance->command_buffer,
+        kernel->pipeline_layout,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        0,
+        32,
+        parameters
+    );
+
+    dispatch_kernel_words(instance, instance->command_buffer, (parameters[7] + 3) / 4);
+
+    image_barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    image_barrier.dstAccessMask = 0;
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkMemoryBarrier memory_barrier = {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_HOST_READ_BIT,
+    };
+
+    instance->vkCmdPipelineBarrier(
+        instance->command_buffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        1,
+        &memory_barrier,
+        0,
+        NULL,
+        1,
+        &image_barrier
+    );
+}
+
+PyObject * Image_meth_read(Image * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {"format", "flip_y", NULL};
+
+    struct {
+        PyObject * format = Py_None;
+        VkBool32 flip_y = false;
+    } args;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "|$Op",
+        keywords,
+        &args.format,
+        &args.flip_y
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
     if (self->mode != IMG_OUTPUT) {
         PyErr_Format(PyExc_ValueError, "not an output image");
         return NULL;
     }
 
+    VkDeviceSize size = self->size;
+    Kernel * kernel = NULL;
+    uint32_t parameters[8] = {};
+
+    if (args.format != Py_None) {
+        uint32_t components = 0;
+        uint32_t type = 0;
+        uint32_t item_size = 0;
+
+        if (!PyUnicode_Check(args.format) || !parse_read_format(args.format, &components, &type, &item_size) || is_integer_format(self->format)) {
+            PyErr_Clear();
+            PyErr_Format(PyExc_ValueError, "format");
+            return NULL;
+        }
+
+        kernel = get_kernel(self->instance, read_kernel);
+
+        if (!kernel) {
+            return NULL;
+        }
+
+        size = (VkDeviceSize)self->extent.width * self->extent.height * self->layers * components * item_size;
+
+        parameters[0] = self->extent.width;
+        parameters[1] = self->extent.height;
+        parameters[2] = self->layers;
+        parameters[3] = components;
+        parameters[4] = type;
+        parameters[5] = args.flip_y;
+        parameters[7] = (uint32_t)size;
+    }
+
+    // The kernel writes whole words, the staging range is rounded up to keep them in bounds.
+    VkDeviceSize reserved = kernel ? (size + 3) & ~3ull : size;
+
     HostBuffer temp = {};
     VkDeviceSize offset = 0;
     if (self->instance->group) {
+        if (kernel) {
+            self->instance->group->offset = (self->instance->group->offset + 3) & ~3ull;
+        }
         temp = self->instance->group->temp;
         temp.ptr = (char *)temp.ptr + self->instance->group->offset;
         offset = self->instance->group->offset;
     } else {
-        new_temp_buffer(self->instance, &temp, self->size);
+        new_temp_buffer(self->instance, &temp, reserved);
         begin_commands(self->instance);
     }
 
-    VkBufferImageCopy copy = {
-        offset,
-        self->extent.width,
-        self->extent.height,
-        {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, self->layers},
-        {0, 0, 0},
-        self->extent,
-    };
+    if (kernel) {
+        parameters[6] = (uint32_t)(offset / 4);
+        record_read_kernel(self, kernel, temp.buffer, parameters);
+    } else if (args.flip_y) {
+        VkDeviceSize row_size = self->size / self->layers / self->extent.height;
+        VkBufferImageCopy * copy_array = allocate<VkBufferImageCopy>(self->extent.height);
+
+        for (uint32_t y = 0; y < self->extent.height; ++y) {
+            copy_array[y] = {
+                offset + row_size * (self->extent.height - y - 1),
+                self->extent.width,
+                self->extent.height,
+                {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, self->layers},
+                {0, (int32_t)y, 0},
+                {self->extent.width, 1, 1},
+            };
+        }
+
+        self->instance->vkCmdCopyImageToBuffer(
+            self->instance->command_buffer,
+            self->image,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            temp.buffer,
+            self->extent.height,
+            copy_array
+        );
 
-    self->instance->vkCmdCopyImageToBuffer(
-        self->instance->command_buffer,
-        self->image,
-        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-        temp.buffer,
-        1,
-        &copy
-    );
+        PyMem_Free(copy_array);
+    } else {
+        VkBufferImageCopy copy = {
+            offset,
+            self->extent.width,
+            self->extent.height,
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, self->layers},
+            {0, 0, 0},
+            self->extent,
+        };
+
+        self->instance->vkCmdCopyImageToBuffer(
+            self->instance->command_buffer,
+            self->image,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            temp.buffer,
+            1,
+            &copy
+        );
+    }
 
     if (self->instance->group) {
-        PyObject * mem = PyMemoryView_FromMemory((char *)temp.ptr, self->size, PyBUF_READ);
+        PyObject * mem = PyMemoryView_FromMemory((char *)temp.ptr, size, PyBUF_READ);
         PyList_Append(self->instance->group->output, mem);
         Py_DECREF(mem);
-        self->instance->group->offset += self->size;
+        self->instance->group->offset += reserved;
         Py_RETURN_NONE;
     }
 
     end_commands(self->instance);
-    PyObject * res = PyBytes_FromStringAndSize((char *)temp.ptr, self->size);
+    PyObject * res = PyBytes_FromStringAndSize((char *)temp.ptr, size);
     free_temp_buffer(self->instance, &temp);
     return res;
 }
@@ -1,5 +1,65 @@
 #include "glnext.hpp"
 
+PyObject * get_device_limits(Instance * self) {
+    VkPhysicalDeviceLimits * limits = &self->physical_device_properties.limits;
+
+    return Py_BuildValue(
+        "{sIs(III)s(III)sIsIsIsKsfsIsI}",
+        "subgroup_size", self->subgroup_properties.subgroupSize,
+        "max_compute_work_group_count", limits->maxComputeWorkGroupCount[0], limits->maxComputeWorkGroupCount[1], limits->maxComputeWorkGroupCount[2],
+        "max_compute_work_group_size", limits->maxComputeWorkGroupSize[0], limits->maxComputeWorkGroupSize[1], limits->maxComputeWorkGroupSize[2],
+        "max_compute_work_group_invocations", limits->maxComputeWorkGroupInvocations,
+        "max_compute_shared_memory_size", limits->maxComputeSharedMemorySize,
+        "max_push_constants_size", limits->maxPushConstantsSize,
+        "max_storage_buffer_range", (unsigned long long)limits->maxStorageBufferRange,
+        "timestamp_period", limits->timestampPeriod,
+        "timestamp_valid_bits", self->timestamp_valid_bits,
+        "max_multiview_view_count", self->max_multiview_view_count
+    );
+}
+
+PyObject * get_device_features(Instance * self, VkPhysicalDeviceShaderFloat16Int8Features * shader_float16_int8) {
+    VkSubgroupFeatureFlags subgroup_operations = 0;
+
+    // Subgroup operations are only reported for compute shaders, the stage the kernels are selected for.
+    if (self->subgroup_properties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) {
+        subgroup_operations = self->subgroup_properties.supportedOperations;
+    }
+
+    return Py_BuildValue(
+        "{sNsNsNsNsNsNsNsNsNsNsNsNsNsNsNsNsNsNsN}",
+        "subgroup_basic", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_BASIC_BIT),
+        "subgroup_vote", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_VOTE_BIT),
+        "subgroup_arithmetic", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_ARITHMETIC_BIT),
+        "subgroup_ballot", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_BALLOT_BIT),
+        "subgroup_shuffle", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_SHUFFLE_BIT),
+        "subgroup_shuffle_relative", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_SHUFFLE_RELATIVE_BIT),
+        "subgroup_clustered", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_CLUSTERED_BIT),
+        "subgroup_quad", PyBool_FromLong(subgroup_operations & VK_SUBGROUP_FEATURE_QUAD_BIT),
+        "shader_float16", PyBool_FromLong(self->extension.shader_float16_int8 && shader_float16_int8->shaderFloat16),
+        "shader_int8", PyBool_FromLong(self->extension.shader_float16_int8 && shader_float16_int8->shaderInt8),
+        "shader_int16", PyBool_FromLong(self->physical_device_features.shaderInt16),
+        "shader_int64", PyBool_FromLong(self->physical_device_features.shaderInt64),
+        "shader_float64", PyBool_FromLong(self->physical_device_features.shaderFloat64),
+        "timestamps", PyBool_FromLong(self->timestamp_valid_bits != 0),
+        "conditional_rendering", PyBool_FromLong(self->extension.conditional_rendering),
+        "dynamic_rendering", PyBool_FromLong(self->extension.dynamic_rendering),
+        "graphics_pipeline_library", PyBool_FromLong(self->extension.graphics_pipeline_library),
+        "mesh_shader", PyBool_FromLong(self->extension.mesh_shader),
+        "multiview", PyBool_FromLong(self->extension.multiview)
+    );
+}
+
+PyObject * save_cache_at_exit(PyObject * ref, PyObject * unused) {
+    PyObject * instance = PyWeakref_GetObject(ref);
+    if (instance == Py_None) {
+        Py_RETURN_NONE;
+    }
+    return Instance_meth_save_cache((Instance *)instance);
+}
+
+PyMethodDef save_cache_at_exit_def = {"save_cache_at_exit", (PyCFunction)save_cache_at_exit, METH_NOARGS, NULL};
+
 Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kwargs) {
     ModuleState * state = (ModuleState *)PyModule_GetState(self);
 
@@ -13,7 +73,9 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         "surface",
         "layers",
         "cache",
+        "cache_path",
         "debug",
+        "deferred",
         NULL,
     };
 
@@ -27,13 +89,15 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         PyObject * surface = Py_False;
         PyObject * layers = Py_None;
         PyObject * cache = Py_None;
+        PyObject * cache_path = Py_None;
         VkBool32 debug = false;
+        VkBool32 deferred = false;
     } args;
 
     int args_ok = PyArg_ParseTupleAndKeywords(
         vargs,
         kwargs,
-        "|$IzIzIzOOOp",
+        "|$IzIzIzOOOOpp",
         keywords,
         &args.physical_device,
         &args.application_name,
@@ -44,7 +108,9 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         &args.surface,
         &args.layers,
         &args.cache,
-        &args.debug
+        &args.cache_path,
+        &args.debug,
+        &args.deferred
     );
 
     if (!args_ok) {
@@ -56,6 +122,12 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         return NULL;
     }
 
+    PyObject * cache_path = NULL;
+
+    if (args.cache_path != Py_None && !PyUnicode_FSConverter(args.cache_path, &cache_path)) {
+        return NULL;
+    }
+
     if (args.layers == Py_None) {
         args.layers = state->empty_list;
     }
@@ -95,10 +167,17 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
     res->command_pool = NULL;
     res->command_buffer = NULL;
     res->pipeline_cache = NULL;
+    res->cache_path = cache_path;
+    res->weakreflist = NULL;
     res->debug_messenger = NULL;
+    res->kernel_sampler = NULL;
 
     res->extension = {};
+    res->max_multiview_view_count = 0;
+    res->subgroup_properties = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES, NULL};
+    res->timestamp_valid_bits = 0;
     res->group = NULL;
+    res->group_index = 0;
 
     res->surface_list = PyList_New(0);
     res->task_list = PyList_New(0);
@@ -106,11 +185,21 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
     res->buffer_list = PyList_New(0);
     res->image_list = PyList_New(0);
     res->log_list = PyList_New(0);
+    res->kernel_dict = PyDict_New();
+    res->primitive_dict = PyDict_New();
+    res->tuning_dict = PyDict_New();
+    res->pending_list = PyList_New(0);
+    res->shader_module_dict = PyDict_New();
+    res->pipeline_layout_dict = PyDict_New();
+    res->render_pass_dict = PyDict_New();
+    res->pipeline_dict = PyDict_New();
+    res->library_dict = PyDict_New();
 
     res->vkGetInstanceProcAddr = vkGetInstanceProcAddr;
     load_library_methods(res);
 
     res->debug = args.debug;
+    res->deferred = args.deferred;
     res->api_version = VK_API_VERSION_1_0;
 
     if (res->vkEnumerateInstanceVersion) {
@@ -168,6 +257,8 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         return NULL;
     }
 
+    res->vkGetPhysicalDeviceProperties(res->physical_device, &res->physical_device_properties);
+
     VkPhysicalDeviceMemoryProperties device_memory_properties = {};
     res->vkGetPhysicalDeviceMemoryProperties(res->physical_device, &device_memory_properties);
 
@@ -214,6 +305,8 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         }
     }
 
+    res->timestamp_valid_bits = queue_family_properties_array[res->queue_family_index].timestampValidBits;
+
     float queue_priority = 1.0f;
 
     VkDeviceQueueCreateInfo device_queue_create_info = {
@@ -228,26 +321,129 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
     VkPhysicalDeviceFeatures physical_device_features = {};
     physical_device_features.multiDrawIndirect = supported_features.multiDrawIndirect;
     physical_device_features.samplerAnisotropy = supported_features.samplerAnisotropy;
+    physical_device_features.shaderInt16 = supported_features.shaderInt16;
+    physical_device_features.shaderInt64 = supported_features.shaderInt64;
+    physical_device_features.shaderFloat64 = supported_features.shaderFloat64;
+    physical_device_features.shaderStorageImageWriteWithoutFormat = supported_features.shaderStorageImageWriteWithoutFormat;
 
     const char * device_extension_array[64];
     uint32_t device_extension_count = load_device_extensions(res, device_extension_array, surface);
 
+    void * device_features_next = NULL;
+
     VkPhysicalDeviceMeshShaderFeaturesNV mesh_shader_features = {
         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_NV,
         NULL,
     };
 
     if (res->extension.mesh_shader) {
+        mesh_shader_features.pNext = device_features_next;
+        device_features_next = &mesh_shader_features;
+    }
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphics_pipeline_library_features = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+        NULL,
+    };
+
+    if (res->extension.graphics_pipeline_library) {
+        graphics_pipeline_library_features.pNext = device_features_next;
+        device_features_next = &graphics_pipeline_library_features;
+    }
+
+    VkPhysicalDeviceMultiviewFeatures multiview_features = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES,
+        NULL,
+    };
+
+    if (res->extension.multiview) {
+        multiview_features.pNext = device_features_next;
+        device_features_next = &multiview_features;
+    }
+
+    VkPhysicalDeviceConditionalRenderingFeaturesEXT conditional_rendering_features = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT,
+        NULL,
+    };
+
+    if (res->extension.conditional_rendering) {
+        conditional_rendering_features.pNext = device_features_next;
+        device_features_next = &conditional_rendering_features;
+    }
+
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamic_rendering_features = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+        NULL,
+    };
+
+    if (res->extension.dynamic_rendering) {
+        dynamic_rendering_features.pNext = device_features_next;
+        device_features_next = &dynamic_rendering_features;
+    }
+
+    VkPhysicalDeviceShaderFloat16Int8Features shader_float16_int8_features = {
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES,
+        NULL,
+    };
+
+    if (res->extension.shader_float16_int8) {
+        shader_float16_int8_features.pNext = device_features_next;
+        device_features_next = &shader_float16_int8_features;
+    }
+
+    if (device_features_next) {
         VkPhysicalDeviceFeatures2 physical_device_features = {
             VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
-            &mesh_shader_features,
+            device_features_next,
         };
         res->vkGetPhysicalDeviceFeatures2(res->physical_device, &physical_device_features);
     }
 
+    if (!graphics_pipeline_library_features.graphicsPipelineLibrary) {
+        res->extension.graphics_pipeline_library = false;
+    }
+
+    if (!conditional_rendering_features.conditionalRendering) {
+        res->extension.conditional_rendering = false;
+    }
+
+    if (!dynamic_rendering_features.dynamicRendering) {
+        res->extension.dynamic_rendering = false;
+    }
+
+    if (!shader_float16_int8_features.shaderFloat16 && !shader_float16_int8_features.shaderInt8) {
+        res->extension.shader_float16_int8 = false;
+    }
+
+    if (!multiview_features.multiview || !res->vkGetPhysicalDeviceProperties2) {
+        res->extension.multiview = false;
+    }
+
+    if (res->extension.multiview) {
+        VkPhysicalDeviceMultiviewProperties multiview_properties = {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_PROPERTIES,
+            NULL,
+        };
+        VkPhysicalDeviceProperties2 physical_device_properties = {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            &multiview_properties,
+        };
+        res->vkGetPhysicalDeviceProperties2(res->physical_device, &physical_device_properties);
+        res->max_multiview_view_count = multiview_properties.maxMultiviewViewCount;
+    }
+
+    if (res->physical_device_properties.apiVersion >= VK_API_VERSION_1_1 && res->vkGetPhysicalDeviceProperties2) {
+        VkPhysicalDeviceProperties2 physical_device_properties = {
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            &res->subgroup_properties,
+        };
+        res->vkGetPhysicalDeviceProperties2(res->physical_device, &physical_device_properties);
+        res->subgroup_properties.pNext = NULL;
+    }
+
     VkDeviceCreateInfo device_create_info = {
         VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        NULL,
+        device_features_next,
         0,
         1,
         &device_queue_create_info,
@@ -258,11 +454,8 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         &physical_device_features,
     };
 
-    if (res->extension.mesh_shader) {
-        device_create_info.pNext = &mesh_shader_features;
-    }
-
     res->vkCreateDevice(res->physical_device, &device_create_info, NULL, &res->device);
+    res->physical_device_features = physical_device_features;
 
     if (!res->device) {
         PyErr_Format(PyExc_RuntimeError, "cannot create device");
@@ -271,6 +464,13 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
 
     load_device_methods(res);
 
+    if (!res->vkCmdBeginRenderingKHR) {
+        res->extension.dynamic_rendering = false;
+    }
+
+    res->limits = get_device_limits(res);
+    res->features = get_device_features(res, &shader_float16_int8_features);
+
     res->vkGetDeviceQueue(res->device, res->queue_family_index, 0, &res->queue);
 
     VkFenceCreateInfo fence_create_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, NULL, 0};
@@ -306,9 +506,86 @@ Instance * glnext_meth_instance(PyObject * self, PyObject * vargs, PyObject * kw
         res->vkCreatePipelineCache(res->device, &pipeline_cache_create_info, NULL, &res->pipeline_cache);
     }
 
+    if (res->cache_path) {
+        if (!res->pipeline_cache) {
+            VkPipelineCacheCreateInfo pipeline_cache_create_info = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO, NULL, 0, 0, NULL};
+            res->vkCreatePipelineCache(res->device, &pipeline_cache_create_info, NULL, &res->pipeline_cache);
+        }
+
+        merge_pipeline_cache_file(res, PyBytes_AsString(res->cache_path));
+
+        PyObject * tuning_path = PyBytes_FromFormat("%s.tuning", PyBytes_AsString(res->cache_path));
+        merge_tuning_file(res, PyBytes_AsString(tuning_path));
+        Py_DECREF(tuning_path);
+
+        // The exit hook only holds a weak reference, instances released earlier save from their dealloc.
+        PyObject * atexit = PyImport_ImportModule("atexit");
+        PyObject * ref = PyWeakref_NewRef((PyObject *)res, NULL);
+        PyObject * save_cache = ref ? PyCFunction_New(&save_cache_at_exit_def, ref) : NULL;
+        PyObject * registered = atexit && save_cache ? PyObject_CallMethod(atexit, "register", "O", save_cache) : NULL;
+        Py_XDECREF(registered);
+        Py_XDECREF(save_cache);
+        Py_XDECREF(ref);
+        Py_XDECREF(atexit);
+
+        if (!registered) {
+            Py_CLEAR(res->cache_path);
+            Py_DECREF(res);
+            return NULL;
+        }
+    }
+
     return res;
 }
 
+bool valid_pipeline_cache(Instance * self, const void * data, size_t size) {
+    const uint32_t header_size = 16 + VK_UUID_SIZE;
+
+    if (size < header_size) {
+        return false;
+    }
+
+    const uint32_t * header = (const uint32_t *)data;
+
+    if (header[0] < header_size || header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        return false;
+    }
+
+    if (header[2] != self->physical_device_properties.vendorID || header[3] != self->physical_device_properties.deviceID) {
+        return false;
+    }
+
+    return !memcmp(header + 4, self->physical_device_properties.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+void merge_pipeline_cache_file(Instance * self, const char * path) {
+    MappedFile mapped = {};
+
+    if (!map_file(&mapped, path)) {
+        return;
+    }
+
+    if (valid_pipeline_cache(self, mapped.ptr, mapped.size)) {
+        VkPipelineCacheCreateInfo pipeline_cache_create_info = {
+            VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            NULL,
+            0,
+            mapped.size,
+            mapped.ptr,
+        };
+
+        VkPipelineCache file_cache = NULL;
+        self->vkCreatePipelineCache(self->device, &pipeline_cache_create_info, NULL, &file_cache);
+
+        if (file_cache) {
+            self->vkMergePipelineCaches(self->device, self->pipeline_cache, 1, &file_cache);
+            self->vkDestroyPipelineCache(self->device, file_cache, NULL);
+        }
+    }
+
+    unmap_file(&mapped);
+}
+
 PyObject * Instance_meth_cache(Instance * self) {
     if (!self->pipeline_cache) {
         PyErr_Format(PyExc_ValueError, "cache not enabled");
@@ -321,6 +598,292 @@ PyObject * Instance_meth_cache(Instance * self) {
     return res;
 }
 
+PyObject * Instance_meth_save_cache(Instance * self) {
+    if (!self->cache_path) {
+        PyErr_Format(PyExc_ValueError, "cache_path not set");
+        return NULL;
+    }
+
+    const char * path = PyBytes_AsString(self->cache_path);
+
+    // Other processes may have saved since this instance was created, keep their pipelines too.
+    merge_pipeline_cache_file(self, path);
+
+    size_t size = 0;
+    self->vkGetPipelineCacheData(self->device, self->pipeline_cache, &size, NULL);
+    char * data = allocate<char>((uint32_t)size);
+    self->vkGetPipelineCacheData(self->device, self->pipeline_cache, &size, data);
+
+    bool written = write_file(path, data, size);
+    PyMem_Free(data);
+
+    if (!written) {
+        PyErr_Format(PyExc_OSError, "cannot write %s", path);
+        return NULL;
+    }
+
+    PyObject * tuning_path = PyBytes_FromFormat("%s.tuning", path);
+    written = save_tuning_file(self, PyBytes_AsString(tuning_path));
+
+    if (!written) {
+        PyErr_Format(PyExc_OSError, "cannot write %s", PyBytes_AsString(tuning_path));
+        Py_DECREF(tuning_path);
+        return NULL;
+    }
+
+    Py_DECREF(tuning_path);
+    Py_RETURN_NONE;
+}
+
+void Instance_dealloc(Instance * self) {
+    if (self->cache_path) {
+        PyObject * res = Instance_meth_save_cache(self);
+        if (!res) {
+            PyErr_WriteUnraisable((PyObject *)self);
+        }
+        Py_XDECREF(res);
+        Py_DECREF(self->cache_path);
+    }
+
+    if (self->weakreflist) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+
+    Py_TYPE(self)->tp_free(self);
+}
+
+struct PipelineBatch {
+    Instance * instance;
+    uint32_t graphics_count;
+    VkGraphicsPipelineCreateInfo * graphics_create_info_array;
+    VkPipeline * graphics_result_array;
+    uint32_t compute_count;
+    VkComputePipelineCreateInfo * compute_create_info_array;
+    VkPipeline * compute_result_array;
+};
+
+void create_pipeline_batch(PipelineBatch batch) {
+    Instance * self = batch.instance;
+
+    if (batch.graphics_count) {
+        self->vkCreateGraphicsPipelines(
+            self->device,
+            self->pipeline_cache,
+            batch.graphics_count,
+            batch.graphics_create_info_array,
+            NULL,
+            batch.graphics_result_array
+        );
+    }
+
+    if (batch.compute_count) {
+        self->vkCreateComputePipelines(
+            self->device,
+            self->pipeline_cache,
+            batch.compute_count,
+            batch.compute_create_info_array,
+            NULL,
+            batch.compute_result_array
+        );
+    }
+}
+
+void compile_pipelines(Instance * self) {
+    uint32_t pending_count = (uint32_t)PyList_Size(self->pending_list);
+
+    if (!pending_count) {
+        return;
+    }
+
+    uint32_t graphics_count = 0;
+    uint32_t compute_count = 0;
+
+    RenderPipeline ** render_pipeline_array = allocate<RenderPipeline *>(pending_count);
+    ComputePipeline ** compute_pipeline_array = allocate<ComputePipeline *>(pending_count);
+    VkGraphicsPipelineCreateInfo * graphics_create_info_array = allocate<VkGraphicsPipelineCreateInfo>(pending_count * 5);
+    VkComputePipelineCreateInfo * compute_create_info_array = allocate<VkComputePipelineCreateInfo>(pending_count);
+    VkPipeline * graphics_result_array = allocate<VkPipeline>(pending_count * 5);
+    VkPipeline * compute_result_array = allocate<VkPipeline>(pending_count);
+
+    // Pipelines with the same state within the batch are created once and shared.
+    PyObject * batch_dict = PyDict_New();
+    PyObject * alias_list = PyList_New(0);
+    PyObject * key_list = PyList_New(0);
+
+    // With pipeline libraries the missing parts are compiled in the batch and the pipelines are linked afterwards.
+    const VkGraphicsPipelineLibraryFlagsEXT library_part_array[] = {
+        VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+    };
+
+    uint32_t library_count = 0;
+    PipelineLibraryState * library_array = allocate<PipelineLibraryState>(pending_count * 4);
+    PyObject * library_batch_dict = PyDict_New();
+    PyObject * library_key_list = PyList_New(0);
+    PyObject * link_list = PyList_New(0);
+
+    for (uint32_t i = 0; i < pending_count; ++i) {
+        PyObject * obj = PyList_GetItem(self->pending_list, i);
+        if (Py_TYPE(obj) == self->state->RenderPipeline_type) {
+            RenderPipeline * pipeline = (RenderPipeline *)obj;
+            PyObject * key = get_pipeline_key(pipeline->pipeline_state);
+            PyObject * cached = PyDict_GetItem(self->pipeline_dict, key);
+            PyObject * first = PyDict_GetItem(batch_dict, key);
+            if (cached) {
+                pipeline->pipeline = (VkPipeline)PyLong_AsVoidPtr(cached);
+                release_pipeline_state(pipeline);
+            } else if (use_pipeline_library(self, pipeline->pipeline_state)) {
+                for (uint32_t j = 0; j < 4; ++j) {
+                    PyObject * library_key = get_pipeline_library_key(pipeline->pipeline_state, library_part_array[j]);
+                    if (!PyDict_GetItem(self->library_dict, library_key) && !PyDict_GetItem(library_batch_dict, library_key)) {
+                        PyDict_SetItem(library_batch_dict, library_key, obj);
+                        PyList_Append(library_key_list, library_key);
+                        fill_pipeline_library(&library_array[library_count++], pipeline->pipeline_state, library_part_array[j]);
+                    }
+                    Py_DECREF(library_key);
+                }
+                PyList_Append(link_list, obj);
+            } else if (first) {
+                PyObject * alias = Py_BuildValue("(OO)", obj, first);
+                PyList_Append(alias_list, alias);
+                Py_DECREF(alias);
+            } else {
+                PyDict_SetItem(batch_dict, key, obj);
+                PyList_Append(key_list, key);
+                graphics_create_info_array[graphics_count] = pipeline->pipeline_state->pipeline_create_info;
+                render_pipeline_array[graphics_count++] = pipeline;
+            }
+            Py_DECREF(key);
+        } else {
+            ComputePipeline * pipeline = (ComputePipeline *)obj;
+            compute_create_info_array[compute_count] = pipeline->pipeline_state->pipeline_create_info;
+            compute_pipeline_array[compute_count++] = pipeline;
+        }
+    }
+
+    for (uint32_t i = 0; i < library_count; ++i) {
+        graphics_create_info_array[graphics_count + i] = library_array[i].pipeline_create_info;
+    }
+
+    uint32_t batch_graphics_count = graphics_count + library_count;
+    uint32_t batch_count = batch_graphics_count > compute_count ? batch_graphics_count : compute_count;
+    uint32_t thread_count = std::thread::hardware_concurrency();
+    thread_count = thread_count ? thread_count : 1;
+    thread_count = thread_count < batch_count ? thread_count : batch_count;
+    thread_count = thread_count ? thread_count : 1;
+
+    PipelineBatch * batch_array = allocate<PipelineBatch>(thread_count);
+
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        uint32_t graphics_begin = batch_graphics_count * i / thread_count;
+        uint32_t graphics_end = batch_graphics_count * (i + 1) / thread_count;
+        uint32_t compute_begin = compute_count * i / thread_count;
+        uint32_t compute_end = compute_count * (i + 1) / thread_count;
+        batch_array[i] = {
+            self,
+            graphics_end - graphics_begin,
+            graphics_create_info_array + graphics_begin,
+            graphics_result_array + graphics_begin,
+            compute_end - compute_begin,
+            compute_create_info_array + compute_begin,
+            compute_result_array + compute_begin,
+        };
+    }
+
+    std::thread * thread_array = new std::thread[thread_count];
+
+    Py_BEGIN_ALLOW_THREADS
+    for (uint32_t i = 1; i < thread_count; ++i) {
+        thread_array[i] = std::thread(create_pipeline_batch, batch_array[i]);
+    }
+    create_pipeline_batch(batch_array[0]);
+    for (uint32_t i = 1; i < thread_count; ++i) {
+        thread_array[i].join();
+    }
+    Py_END_ALLOW_THREADS
+
+    delete[] thread_array;
+
+    for (uint32_t i = 0; i < graphics_count; ++i) {
+        PyObject * ptr = PyLong_FromVoidPtr(graphics_result_array[i]);
+        PyDict_SetItem(self->pipeline_dict, PyList_GetItem(key_list, i), ptr);
+        Py_DECREF(ptr);
+        render_pipeline_array[i]->pipeline = graphics_result_array[i];
+        release_pipeline_state(render_pipeline_array[i]);
+    }
+
+    for (uint32_t i = 0; i < library_count; ++i) {
+        PyObject * ptr = PyLong_FromVoidPtr(graphics_result_array[graphics_count + i]);
+        PyDict_SetItem(self->library_dict, PyList_GetItem(library_key_list, i), ptr);
+        Py_DECREF(ptr);
+    }
+
+    // Every part is cached now, the fast link does not compile shaders.
+    for (uint32_t i = 0; i < PyList_Size(link_list); ++i) {
+        RenderPipeline * pipeline = (RenderPipeline *)PyList_GetItem(link_list, i);
+        PyObject * key = get_pipeline_key(pipeline->pipeline_state);
+        PyObject * cached = PyDict_GetItem(self->pipeline_dict, key);
+        if (cached) {
+            pipeline->pipeline = (VkPipeline)PyLong_AsVoidPtr(cached);
+        } else {
+            pipeline->pipeline = create_graphics_pipeline(self, pipeline->pipeline_state);
+            PyObject * ptr = PyLong_FromVoidPtr(pipeline->pipeline);
+            PyDict_SetItem(self->pipeline_dict, key, ptr);
+            Py_DECREF(ptr);
+        }
+        release_pipeline_state(pipeline);
+        Py_DECREF(key);
+    }
+
+    for (uint32_t i = 0; i < PyList_Size(alias_list); ++i) {
+        PyObject * alias = PyList_GetItem(alias_list, i);
+        RenderPipeline * pipeline = (RenderPipeline *)PyTuple_GetItem(alias, 0);
+        pipeline->pipeline = ((RenderPipeline *)PyTuple_GetItem(alias, 1))->pipeline;
+        release_pipeline_state(pipeline);
+    }
+
+    Py_DECREF(batch_dict);
+    Py_DECREF(alias_list);
+    Py_DECREF(key_list);
+    Py_DECREF(library_batch_dict);
+    Py_DECREF(library_key_list);
+    Py_DECREF(link_list);
+
+    for (uint32_t i = 0; i < compute_count; ++i) {
+        compute_pipeline_array[i]->pipeline = compute_result_array[i];
+        release_pipeline_state(compute_pipeline_array[i]);
+    }
+
+    PyMem_Free(batch_array);
+    PyMem_Free(library_array);
+    PyMem_Free(render_pipeline_array);
+    PyMem_Free(compute_pipeline_array);
+    PyMem_Free(graphics_create_info_array);
+    PyMem_Free(compute_create_info_array);
+    PyMem_Free(graphics_result_array);
+    PyMem_Free(compute_result_array);
+
+    PyList_SetSlice(self->pending_list, 0, pending_count, NULL);
+}
+
+PyObject * Instance_get_stats(Instance * self) {
+    return Py_BuildValue(
+        "{snsnsnsnsn}",
+        "shader_modules", PyDict_Size(self->shader_module_dict),
+        "pipeline_layouts", PyDict_Size(self->pipeline_layout_dict),
+        "render_passes", PyDict_Size(self->render_pass_dict),
+        "pipelines", PyDict_Size(self->pipeline_dict),
+        "pipeline_libraries", PyDict_Size(self->library_dict)
+    );
+}
+
+PyObject * Instance_meth_compile(Instance * self) {
+    compile_pipelines(self);
+    Py_RETURN_NONE;
+}
+
 PyObject * Instance_meth_present(Instance * self) {
     uint32_t surface_count = (uint32_t)PyList_Size(self->surface_list);
 
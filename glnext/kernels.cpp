@@ -0,0 +1,198 @@
+#include "glnext.hpp"
+#include "spirv.hpp"
+
+const VkDescriptorType read_kernel_binding_array[] = {
+    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+const KernelInfo read_kernel = {"read", &read_kernel_code, 2, read_kernel_binding_array, 32};
+
+const VkDescriptorType cull_kernel_binding_array[] = {
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+const KernelInfo cull_kernel = {"cull", &cull_kernel_code, 4, cull_kernel_binding_array, 72};
+
+const VkDescriptorType mipmap_kernel_binding_array[] = {
+    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+};
+
+const KernelInfo mipmap_kernel = {"mipmap", &mipmap_kernel_code, 15, mipmap_kernel_binding_array, 28};
+
+const PrimitiveInfo reduce_primitive = {"reduce", &reduce_primitive_subgroup_code, &reduce_primitive_code};
+const PrimitiveInfo partial_primitive = {"partial", &partial_primitive_subgroup_code, &partial_primitive_code};
+const PrimitiveInfo scan_primitive = {"scan", &scan_primitive_subgroup_code, &scan_primitive_code};
+const PrimitiveInfo compact_primitive = {"compact", &compact_primitive_subgroup_code, &compact_primitive_code};
+const PrimitiveInfo histogram_primitive = {"histogram", &histogram_primitive_subgroup_code, &histogram_primitive_code};
+const PrimitiveInfo scatter_primitive = {"scatter", &scatter_primitive_subgroup_code, &scatter_primitive_code};
+
+PyObject * get_kernel_code(const KernelCode * code) {
+    // The kernels are compiled by setup.py, builds without a shader compiler only have empty entries.
+    if (!code->size) {
+        PyErr_Format(PyExc_RuntimeError, "built-in kernels are not available in this build");
+        return NULL;
+    }
+
+    return PyBytes_FromStringAndSize((const char *)code->words, code->size);
+}
+
+Kernel * get_kernel(Instance * self, KernelInfo info) {
+    PyObject * cached = PyDict_GetItemString(self->kernel_dict, info.name);
+    if (cached) {
+        return (Kernel *)PyLong_AsVoidPtr(cached);
+    }
+
+    PyObject * spv = get_kernel_code(info.code);
+    if (!spv) {
+        return NULL;
+    }
+
+    Kernel * res = allocate<Kernel>(1);
+
+    VkDescriptorSetLayoutBinding * descriptor_binding_array = allocate<VkDescriptorSetLayoutBinding>(info.binding_count);
+
+    for (uint32_t i = 0; i < info.binding_count; ++i) {
+        descriptor_binding_array[i] = {i, info.binding_type_array[i], 1, VK_SHADER_STAGE_COMPUTE_BIT, NULL};
+    }
+
+    VkPushConstantRange push_constant_range = {VK_SHADER_STAGE_COMPUTE_BIT, 0, info.push_constant_size};
+
+    PipelineLayout * pipeline_layout = get_pipeline_layout(
+        self,
+        info.binding_count,
+        descriptor_binding_array,
+        info.push_constant_size ? &push_constant_range : NULL
+    );
+
+    PyMem_Free(descriptor_binding_array);
+
+    res->descriptor_set_layout = pipeline_layout->descriptor_set_layout;
+    res->pipeline_layout = pipeline_layout->pipeline_layout;
+
+    VkShaderModule shader_module = get_shader_module(self, spv);
+    Py_DECREF(spv);
+
+    VkComputePipelineCreateInfo pipeline_create_info = {
+        VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        NULL,
+        0,
+        {
+            VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            NULL,
+            0,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            shader_module,
+            "main",
+            NULL,
+        },
+        res->pipeline_layout,
+        NULL,
+        0,
+    };
+
+    self->vkCreateComputePipelines(self->device, self->pipeline_cache, 1, &pipeline_create_info, NULL, &res->pipeline);
+
+    PyObject * ptr = PyLong_FromVoidPtr(res);
+    PyDict_SetItemString(self->kernel_dict, info.name, ptr);
+    Py_DECREF(ptr);
+    return res;
+}
+
+VkSampler get_kernel_sampler(Instance * self) {
+    if (self->kernel_sampler) {
+        return self->kernel_sampler;
+    }
+
+    VkSamplerCreateInfo sampler_create_info = {
+        VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+        NULL,
+        0,
+        VK_FILTER_NEAREST,
+        VK_FILTER_NEAREST,
+        VK_SAMPLER_MIPMAP_MODE_NEAREST,
+        VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        0.0f,
+        false,
+        1.0f,
+        false,
+        VK_COMPARE_OP_NEVER,
+        0.0f,
+        1000.0f,
+        VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK,
+        false,
+    };
+
+    self->vkCreateSampler(self->device, &sampler_create_info, NULL, &self->kernel_sampler);
+    return self->kernel_sampler;
+}
+
+void dispatch_kernel_words(Instance * self, VkCommandBuffer command_buffer, uint32_t words) {
+    uint32_t groups = (words + 63) / 64;
+    uint32_t groups_x = groups < 1024 ? groups : 1024;
+    uint32_t groups_y = (groups + groups_x - 1) / groups_x;
+    self->vkCmdDispatch(command_buffer, groups_x, groups_y, 1);
+}
+
+Kernel * get_mipmap_kernel(Instance * self) {
+    PyObject * cached = PyDict_GetItemString(self->kernel_dict, mipmap_kernel.name);
+    if (cached) {
+        return (Kernel *)PyLong_AsVoidPtr(cached);
+    }
+
+    // Without the kernel the mipmaps are still built with blits, the failure is remembered as a null kernel.
+    Kernel * res = get_kernel(self, mipmap_kernel);
+    if (!res) {
+        PyErr_Clear();
+        PyObject * ptr = PyLong_FromVoidPtr(NULL);
+        PyDict_SetItemString(self->kernel_dict, mipmap_kernel.name, ptr);
+        Py_DECREF(ptr);
+    }
+
+    return res;
+}
+
+PyObject * get_primitive_shader(Instance * self, PrimitiveInfo info) {
+    PyObject * cached = PyDict_GetItemString(self->primitive_dict, info.name);
+    if (cached) {
+        return cached;
+    }
+
+    VkSubgroupFeatureFlags subgroup_operations = VK_SUBGROUP_FEATURE_BASIC_BIT | VK_SUBGROUP_FEATURE_ARITHMETIC_BIT;
+
+    // The subgroup variant needs at most one subgroup total per invocation of the first subgroup.
+    bool subgroup = (
+        info.subgroup_code->size &&
+        self->subgroup_properties.subgroupSize >= 16 &&
+        (self->subgroup_properties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) &&
+        (self->subgroup_properties.supportedOperations & subgroup_operations) == subgroup_operations
+    );
+
+    PyObject * spv = get_kernel_code(subgroup ? info.subgroup_code : info.code);
+    if (!spv) {
+        return NULL;
+    }
+
+    PyDict_SetItemString(self->primitive_dict, info.name, spv);
+    Py_DECREF(spv);
+    return spv;
+}
@@ -0,0 +1,107 @@
+layout (local_size_x = 256) in;
+
+layout (push_constant) uniform Parameters {
+    uint count;
+    uint format;
+    uint op;
+    uint flags;
+    uint shift;
+    uint block_count;
+};
+
+const uint FLAG_EXCLUSIVE = 1u;
+const uint FLAG_PREDICATE = 2u;
+const uint FLAG_VALUES = 4u;
+
+shared uint workgroup_data[256];
+
+uint block_index() {
+    return gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x;
+}
+
+uint identity() {
+    if (op == 1) {
+        if (format == 1) return 0x7fffffffu;
+        if (format == 2) return 0x7f800000u;
+        return 0xffffffffu;
+    }
+    if (op == 2) {
+        if (format == 1) return 0x80000000u;
+        if (format == 2) return 0xff800000u;
+        return 0u;
+    }
+    return 0u;
+}
+
+uint combine(uint a, uint b) {
+    if (format == 1) {
+        int x = int(a);
+        int y = int(b);
+        return uint(op == 1 ? min(x, y) : op == 2 ? max(x, y) : x + y);
+    }
+    if (format == 2) {
+        float x = uintBitsToFloat(a);
+        float y = uintBitsToFloat(b);
+        return floatBitsToUint(op == 1 ? min(x, y) : op == 2 ? max(x, y) : x + y);
+    }
+    return op == 1 ? min(a, b) : op == 2 ? max(a, b) : a + b;
+}
+
+uint sort_key(uint key) {
+    if (format == 1) return key ^ 0x80000000u;
+    if (format == 2) return (key & 0x80000000u) != 0 ? ~key : key | 0x80000000u;
+    return key;
+}
+
+#ifdef SUBGROUP
+
+shared uint subgroup_prefix[256];
+
+uint subgroup_exclusive_scan(uint value) {
+    if (format == 1) {
+        int x = int(value);
+        return uint(op == 1 ? subgroupExclusiveMin(x) : op == 2 ? subgroupExclusiveMax(x) : subgroupExclusiveAdd(x));
+    }
+    if (format == 2) {
+        float x = uintBitsToFloat(value);
+        return floatBitsToUint(op == 1 ? subgroupExclusiveMin(x) : op == 2 ? subgroupExclusiveMax(x) : subgroupExclusiveAdd(x));
+    }
+    return op == 1 ? subgroupExclusiveMin(value) : op == 2 ? subgroupExclusiveMax(value) : subgroupExclusiveAdd(value);
+}
+
+uint workgroup_exclusive_scan(uint value, out uint total) {
+    barrier();
+    uint prefix = subgroup_exclusive_scan(value);
+    if (gl_SubgroupInvocationID == gl_SubgroupSize - 1) {
+        workgroup_data[gl_SubgroupID] = combine(prefix, value);
+    }
+    barrier();
+    if (gl_SubgroupID == 0) {
+        uint subgroup_total = gl_SubgroupInvocationID < gl_NumSubgroups ? workgroup_data[gl_SubgroupInvocationID] : identity();
+        subgroup_prefix[gl_SubgroupInvocationID] = subgroup_exclusive_scan(subgroup_total);
+    }
+    barrier();
+    total = combine(subgroup_prefix[gl_NumSubgroups - 1], workgroup_data[gl_NumSubgroups - 1]);
+    return combine(subgroup_prefix[gl_SubgroupID], prefix);
+}
+
+#else
+
+uint workgroup_exclusive_scan(uint value, out uint total) {
+    uint index = gl_LocalInvocationID.x;
+    uint inclusive = value;
+    barrier();
+    workgroup_data[index] = inclusive;
+    barrier();
+    for (uint offset = 1; offset < 256; offset <<= 1) {
+        uint other = index >= offset ? workgroup_data[index - offset] : identity();
+        barrier();
+        inclusive = combine(other, inclusive);
+        workgroup_data[index] = inclusive;
+        barrier();
+    }
+    total = workgroup_data[255];
+    return index > 0 ? workgroup_data[index - 1] : identity();
+}
+
+#endif
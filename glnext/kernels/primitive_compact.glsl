@@ -0,0 +1,35 @@
+layout (std430, binding = 0) readonly buffer Mask {
+    uint mask_data[];
+};
+
+layout (std430, binding = 1) readonly buffer Partial {
+    uint partial_data[];
+};
+
+layout (std430, binding = 2) readonly buffer Input {
+    uint input_data[];
+};
+
+layout (std430, binding = 3) writeonly buffer Output {
+    uint output_data[];
+};
+
+void main() {
+    uint block = block_index();
+    if (block >= block_count) {
+        return;
+    }
+
+    uint carry = partial_data[block];
+
+    for (uint i = 0; i < 4; ++i) {
+        uint index = block * 1024 + i * 256 + gl_LocalInvocationID.x;
+        uint keep = index < count && mask_data[index] != 0 ? 1u : 0u;
+        uint total;
+        uint prefix = workgroup_exclusive_scan(keep, total);
+        if (keep != 0) {
+            output_data[carry + prefix] = input_data[index];
+        }
+        carry += total;
+    }
+}
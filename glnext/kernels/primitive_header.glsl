@@ -0,0 +1,2 @@
+#version 450
+#pragma shader_stage(compute)
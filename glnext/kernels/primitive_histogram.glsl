@@ -0,0 +1,27 @@
+layout (std430, binding = 0) readonly buffer Keys {
+    uint key_data[];
+};
+
+layout (std430, binding = 1) writeonly buffer Histogram {
+    uint histogram_data[];
+};
+
+void main() {
+    uint block = block_index();
+    if (block >= block_count) {
+        return;
+    }
+
+    workgroup_data[gl_LocalInvocationID.x] = 0u;
+    barrier();
+
+    for (uint i = 0; i < 4; ++i) {
+        uint index = block * 1024 + i * 256 + gl_LocalInvocationID.x;
+        if (index < count) {
+            atomicAdd(workgroup_data[(sort_key(key_data[index]) >> shift) & 255u], 1u);
+        }
+    }
+
+    barrier();
+    histogram_data[gl_LocalInvocationID.x * block_count + block] = workgroup_data[gl_LocalInvocationID.x];
+}
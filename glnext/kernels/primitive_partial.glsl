@@ -0,0 +1,26 @@
+layout (std430, binding = 0) buffer Partial {
+    uint partial_data[];
+};
+
+layout (std430, binding = 1) writeonly buffer Total {
+    uint total_data[];
+};
+
+void main() {
+    uint carry = identity();
+
+    for (uint base = 0; base < block_count; base += 256) {
+        uint index = base + gl_LocalInvocationID.x;
+        uint value = index < block_count ? partial_data[index] : identity();
+        uint total;
+        uint prefix = workgroup_exclusive_scan(value, total);
+        if (index < block_count) {
+            partial_data[index] = combine(carry, prefix);
+        }
+        carry = combine(carry, total);
+    }
+
+    if (gl_LocalInvocationID.x == 0) {
+        total_data[0] = carry;
+    }
+}
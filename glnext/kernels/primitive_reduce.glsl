@@ -0,0 +1,32 @@
+layout (std430, binding = 0) readonly buffer Input {
+    uint input_data[];
+};
+
+layout (std430, binding = 1) writeonly buffer Partial {
+    uint partial_data[];
+};
+
+uint load(uint index) {
+    if (index >= count) return identity();
+    if ((flags & FLAG_PREDICATE) != 0) return input_data[index] != 0 ? 1u : 0u;
+    return input_data[index];
+}
+
+void main() {
+    uint block = block_index();
+    if (block >= block_count) {
+        return;
+    }
+
+    uint value = identity();
+    for (uint i = 0; i < 4; ++i) {
+        value = combine(value, load(block * 1024 + i * 256 + gl_LocalInvocationID.x));
+    }
+
+    uint total;
+    workgroup_exclusive_scan(value, total);
+
+    if (gl_LocalInvocationID.x == 0) {
+        partial_data[block] = total;
+    }
+}
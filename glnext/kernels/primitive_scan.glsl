@@ -0,0 +1,31 @@
+layout (std430, binding = 0) readonly buffer Input {
+    uint input_data[];
+};
+
+layout (std430, binding = 1) readonly buffer Partial {
+    uint partial_data[];
+};
+
+layout (std430, binding = 2) writeonly buffer Output {
+    uint output_data[];
+};
+
+void main() {
+    uint block = block_index();
+    if (block >= block_count) {
+        return;
+    }
+
+    uint carry = partial_data[block];
+
+    for (uint i = 0; i < 4; ++i) {
+        uint index = block * 1024 + i * 256 + gl_LocalInvocationID.x;
+        uint value = index < count ? input_data[index] : identity();
+        uint total;
+        uint prefix = combine(carry, workgroup_exclusive_scan(value, total));
+        if (index < count) {
+            output_data[index] = (flags & FLAG_EXCLUSIVE) != 0 ? prefix : combine(prefix, value);
+        }
+        carry = combine(carry, total);
+    }
+}
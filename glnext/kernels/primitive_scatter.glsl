@@ -0,0 +1,64 @@
+layout (std430, binding = 0) readonly buffer Keys {
+    uint key_data[];
+};
+
+layout (std430, binding = 1) readonly buffer Offset {
+    uint offset_data[];
+};
+
+layout (std430, binding = 2) writeonly buffer SortedKeys {
+    uint sorted_key_data[];
+};
+
+layout (std430, binding = 3) readonly buffer Values {
+    uint value_data[];
+};
+
+layout (std430, binding = 4) writeonly buffer SortedValues {
+    uint sorted_value_data[];
+};
+
+shared uint digit_offset[256];
+
+void main() {
+    uint block = block_index();
+    if (block >= block_count) {
+        return;
+    }
+
+    uint local_index = gl_LocalInvocationID.x;
+    digit_offset[local_index] = offset_data[local_index * block_count + block];
+
+    // Keys of the same digit keep their order, the ranks within a row come from shared memory.
+    for (uint i = 0; i < 4; ++i) {
+        uint index = block * 1024 + i * 256 + local_index;
+        uint key = index < count ? key_data[index] : 0u;
+        uint digit = index < count ? (sort_key(key) >> shift) & 255u : 256u;
+
+        barrier();
+        workgroup_data[local_index] = digit;
+        barrier();
+
+        uint rank = 0;
+        bool last = true;
+        for (uint j = 0; j < 256; ++j) {
+            if (workgroup_data[j] == digit) {
+                rank += j < local_index ? 1u : 0u;
+                last = last && j <= local_index;
+            }
+        }
+
+        if (digit < 256) {
+            uint position = digit_offset[digit] + rank;
+            sorted_key_data[position] = key;
+            if ((flags & FLAG_VALUES) != 0) {
+                sorted_value_data[position] = value_data[index];
+            }
+        }
+
+        barrier();
+        if (digit < 256 && last) {
+            digit_offset[digit] += rank + 1;
+        }
+    }
+}
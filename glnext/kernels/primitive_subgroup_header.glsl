@@ -0,0 +1,4 @@
+#version 450
+#pragma shader_stage(compute)
+#extension GL_KHR_shader_subgroup_arithmetic : require
+#define SUBGROUP 1
@@ -46,6 +46,7 @@ void load_instance_methods(Instance * self) {
     load(vkEnumerateDeviceExtensionProperties);
     load(vkGetPhysicalDeviceProperties);
     load(vkGetPhysicalDeviceFeatures2);
+    load(vkGetPhysicalDeviceProperties2);
     load(vkGetPhysicalDeviceMemoryProperties);
     load(vkGetPhysicalDeviceFeatures);
     load(vkGetPhysicalDeviceFormatProperties);
@@ -71,8 +72,10 @@ void load_device_methods(Instance * self) {
 
     load(vkGetDeviceQueue);
     load(vkCreateFence);
+    load(vkDestroyFence);
     load(vkCreateCommandPool);
     load(vkAllocateCommandBuffers);
+    load(vkFreeCommandBuffers);
     load(vkGetImageMemoryRequirements);
     load(vkCmdCopyImageToBuffer);
     load(vkCreateShaderModule);
@@ -80,12 +83,20 @@ void load_device_methods(Instance * self) {
     load(vkCmdCopyBufferToImage);
     load(vkCreateImageView);
     load(vkCmdDispatch);
+    load(vkCmdDispatchIndirect);
+    load(vkCreateQueryPool);
+    load(vkDestroyQueryPool);
+    load(vkCmdResetQueryPool);
+    load(vkCmdWriteTimestamp);
+    load(vkGetQueryPoolResults);
     load(vkCmdBindIndexBuffer);
     load(vkBindImageMemory);
     load(vkFreeMemory);
     load(vkCmdSetViewport);
     load(vkCmdBindDescriptorSets);
     load(vkCmdCopyBuffer);
+    load(vkCmdFillBuffer);
+    load(vkCmdUpdateBuffer);
     load(vkCmdPushConstants);
     load(vkUnmapMemory);
     load(vkEndCommandBuffer);
@@ -99,16 +110,23 @@ void load_device_methods(Instance * self) {
     load(vkCreatePipelineLayout);
     load(vkCreatePipelineCache);
     load(vkGetPipelineCacheData);
+    load(vkMergePipelineCaches);
+    load(vkDestroyPipelineCache);
     load(vkCmdSetScissor);
     load(vkCmdBindPipeline);
     load(vkCreateGraphicsPipelines);
     load(vkCreateDescriptorSetLayout);
     load(vkCmdEndRenderPass);
+    load(vkCmdNextSubpass);
+    load(vkCmdBeginConditionalRenderingEXT);
+    load(vkCmdEndConditionalRenderingEXT);
     load(vkCmdExecuteCommands);
     load(vkCmdPipelineBarrier);
     load(vkCreateDescriptorPool);
     load(vkCreateImage);
     load(vkCmdBeginRenderPass);
+    load(vkCmdBeginRenderingKHR);
+    load(vkCmdEndRenderingKHR);
     load(vkCreateComputePipelines);
     load(vkBeginCommandBuffer);
     load(vkCreateFramebuffer);
@@ -141,4 +159,9 @@ void load_device_methods(Instance * self) {
     load(vkDestroySwapchainKHR);
 
     #undef load
+
+    if (!self->vkCmdBeginRenderingKHR) {
+        self->vkCmdBeginRenderingKHR = (PFN_vkCmdBeginRenderingKHR)self->vkGetDeviceProcAddr(self->device, "vkCmdBeginRendering");
+        self->vkCmdEndRenderingKHR = (PFN_vkCmdEndRenderingKHR)self->vkGetDeviceProcAddr(self->device, "vkCmdEndRendering");
+    }
 }
@@ -0,0 +1,575 @@
+#include "glnext.hpp"
+
+const uint32_t primitive_block_size = 1024;
+
+const uint32_t primitive_exclusive_flag = 1;
+const uint32_t primitive_predicate_flag = 2;
+const uint32_t primitive_values_flag = 4;
+
+struct PrimitiveParameters {
+    uint32_t count;
+    uint32_t format;
+    uint32_t op;
+    uint32_t flags;
+    uint32_t shift;
+    uint32_t block_count;
+};
+
+struct PrimitiveBinding {
+    const char * type;
+    Buffer * buffer;
+};
+
+int get_primitive_format(PyObject * name) {
+    if (!PyUnicode_CompareWithASCIIString(name, "I")) {
+        return 0;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "i")) {
+        return 1;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "f")) {
+        return 2;
+    }
+    return -1;
+}
+
+int get_primitive_op(PyObject * name) {
+    if (!PyUnicode_CompareWithASCIIString(name, "add")) {
+        return 0;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "min")) {
+        return 1;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "max")) {
+        return 2;
+    }
+    return -1;
+}
+
+uint32_t get_primitive_block_count(uint32_t count) {
+    return (count + primitive_block_size - 1) / primitive_block_size;
+}
+
+Buffer * new_primitive_buffer(Instance * self, VkDeviceSize size) {
+    Memory * memory = new_memory(self);
+
+    Buffer * res = new_buffer({
+        self,
+        memory,
+        size,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    });
+
+    allocate_memory(memory);
+    bind_buffer(res);
+    return res;
+}
+
+Buffer * get_primitive_buffer(Instance * self, PyObject * obj, VkDeviceSize size, const char * name) {
+    if (obj == Py_None) {
+        return new_primitive_buffer(self, size);
+    }
+
+    Buffer * buffer = get_buffer(self, obj);
+    if (!buffer) {
+        return NULL;
+    }
+
+    if (!(buffer->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) || buffer->size < size) {
+        PyErr_Format(PyExc_ValueError, "%s", name);
+        return NULL;
+    }
+
+    Py_INCREF(buffer);
+    return buffer;
+}
+
+bool record_primitive(Task * self, PrimitiveInfo primitive, uint32_t group_count, PrimitiveBinding * binding_array, uint32_t binding_count, PrimitiveParameters parameters) {
+    Instance * instance = self->instance;
+
+    PyObject * shader = get_primitive_shader(instance, primitive);
+    if (!shader) {
+        return false;
+    }
+
+    uint32_t groups_x = group_count < 1024 ? group_count : 1024;
+    uint32_t groups_y = (group_count + groups_x - 1) / groups_x;
+
+    PyObject * bindings = PyList_New(binding_count);
+    for (uint32_t i = 0; i < binding_count; ++i) {
+        PyObject * binding = Py_BuildValue(
+            "{sIsssO}",
+            "binding", i,
+            "type", binding_array[i].type,
+            "buffer", binding_array[i].buffer
+        );
+        PyList_SET_ITEM(bindings, i, binding);
+    }
+
+    PyObject * vargs = PyTuple_New(0);
+    PyObject * kwargs = Py_BuildValue(
+        "{sOs(II)sOsI}",
+        "compute_shader", shader,
+        "compute_count", groups_x, groups_y,
+        "bindings", bindings,
+        "push_constants", (uint32_t)sizeof(PrimitiveParameters)
+    );
+
+    ComputePipeline * pipeline = new_compute_pipeline(instance, vargs, kwargs);
+
+    Py_DECREF(bindings);
+    Py_DECREF(kwargs);
+    Py_DECREF(vargs);
+
+    if (!pipeline) {
+        return false;
+    }
+
+    memcpy(pipeline->push_constant_data, &parameters, sizeof(PrimitiveParameters));
+    PyList_Append(self->task_list, (PyObject *)pipeline);
+    Py_DECREF(pipeline);
+    return true;
+}
+
+bool record_reduce(Task * self, Buffer * input, Buffer * partial, Buffer * total, PrimitiveParameters parameters) {
+    PrimitiveBinding reduce_bindings[] = {
+        {"input_buffer", input},
+        {"output_buffer", partial},
+    };
+
+    PrimitiveParameters reduce_parameters = parameters;
+    reduce_parameters.flags &= primitive_predicate_flag;
+
+    if (!record_primitive(self, reduce_primitive, parameters.block_count, reduce_bindings, 2, reduce_parameters)) {
+        return false;
+    }
+
+    // The partials turn into the exclusive prefix of each block and the total is the reduction.
+    PrimitiveBinding partial_bindings[] = {
+        {"storage_buffer", partial},
+        {"output_buffer", total},
+    };
+
+    PrimitiveParameters partial_parameters = parameters;
+    partial_parameters.flags = 0;
+
+    return record_primitive(self, partial_primitive, 1, partial_bindings, 2, partial_parameters);
+}
+
+bool record_scan(Task * self, Buffer * input, Buffer * output, Buffer * partial, Buffer * total, PrimitiveParameters parameters) {
+    if (!record_reduce(self, input, partial, total, parameters)) {
+        return false;
+    }
+
+    PrimitiveBinding scan_bindings[] = {
+        {"input_buffer", input},
+        {"input_buffer", partial},
+        {"output_buffer", output},
+    };
+
+    return record_primitive(self, scan_primitive, parameters.block_count, scan_bindings, 3, parameters);
+}
+
+PyObject * Task_meth_scan(Task * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {"buffer", "count", "output", "format", "op", "exclusive", NULL};
+
+    struct {
+        Buffer * buffer;
+        uint32_t count;
+        PyObject * output = Py_None;
+        PyObject * format;
+        PyObject * op;
+        VkBool32 exclusive = false;
+    } args;
+
+    args.format = self->instance->state->default_primitive_format;
+    args.op = self->instance->state->default_primitive_op;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "O!I|$OO!O!p",
+        keywords,
+        self->instance->state->Buffer_type,
+        &args.buffer,
+        &args.count,
+        &args.output,
+        &PyUnicode_Type,
+        &args.format,
+        &PyUnicode_Type,
+        &args.op,
+        &args.exclusive
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (!args.count || (VkDeviceSize)args.count * 4 > args.buffer->size) {
+        PyErr_Format(PyExc_ValueError, "count");
+        return NULL;
+    }
+
+    if (!(args.buffer->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+        PyErr_Format(PyExc_ValueError, "buffer");
+        return NULL;
+    }
+
+    int format = get_primitive_format(args.format);
+    if (format < 0) {
+        PyErr_Format(PyExc_ValueError, "format");
+        return NULL;
+    }
+
+    int op = get_primitive_op(args.op);
+    if (op < 0) {
+        PyErr_Format(PyExc_ValueError, "op");
+        return NULL;
+    }
+
+    Buffer * output = get_primitive_buffer(self->instance, args.output, (VkDeviceSize)args.count * 4, "output");
+    if (!output) {
+        return NULL;
+    }
+
+    uint32_t block_count = get_primitive_block_count(args.count);
+
+    Buffer * partial = new_primitive_buffer(self->instance, block_count * 4);
+    Buffer * total = new_primitive_buffer(self->instance, 4);
+
+    PrimitiveParameters parameters = {
+        args.count,
+        (uint32_t)format,
+        (uint32_t)op,
+        args.exclusive ? primitive_exclusive_flag : 0,
+        0,
+        block_count,
+    };
+
+    bool recorded = record_scan(self, args.buffer, output, partial, total, parameters);
+
+    Py_DECREF(partial);
+    Py_DECREF(total);
+
+    if (!recorded) {
+        Py_DECREF(output);
+        return NULL;
+    }
+
+    return (PyObject *)output;
+}
+
+PyObject * Task_meth_reduce(Task * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {"buffer", "count", "output", "format", "op", NULL};
+
+    struct {
+        Buffer * buffer;
+        uint32_t count;
+        PyObject * output = Py_None;
+        PyObject * format;
+        PyObject * op;
+    } args;
+
+    args.format = self->instance->state->default_primitive_format;
+    args.op = self->instance->state->default_primitive_op;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "O!I|$OO!O!",
+        keywords,
+        self->instance->state->Buffer_type,
+        &args.buffer,
+        &args.count,
+        &args.output,
+        &PyUnicode_Type,
+        &args.format,
+        &PyUnicode_Type,
+        &args.op
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (!args.count || (VkDeviceSize)args.count * 4 > args.buffer->size) {
+        PyErr_Format(PyExc_ValueError, "count");
+        return NULL;
+    }
+
+    if (!(args.buffer->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+        PyErr_Format(PyExc_ValueError, "buffer");
+        return NULL;
+    }
+
+    int format = get_primitive_format(args.format);
+    if (format < 0) {
+        PyErr_Format(PyExc_ValueError, "format");
+        return NULL;
+    }
+
+    int op = get_primitive_op(args.op);
+    if (op < 0) {
+        PyErr_Format(PyExc_ValueError, "op");
+        return NULL;
+    }
+
+    Buffer * output = get_primitive_buffer(self->instance, args.output, 4, "output");
+    if (!output) {
+        return NULL;
+    }
+
+    uint32_t block_count = get_primitive_block_count(args.count);
+
+    Buffer * partial = new_primitive_buffer(self->instance, block_count * 4);
+
+    PrimitiveParameters parameters = {
+        args.count,
+        (uint32_t)format,
+        (uint32_t)op,
+        0,
+        0,
+        block_count,
+    };
+
+    bool recorded = record_reduce(self, args.buffer, partial, output, parameters);
+
+    Py_DECREF(partial);
+
+    if (!recorded) {
+        Py_DECREF(output);
+        return NULL;
+    }
+
+    return (PyObject *)output;
+}
+
+PyObject * Task_meth_compact(Task * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {"buffer", "count", "mask", "output", "output_count", NULL};
+
+    struct {
+        Buffer * buffer;
+        uint32_t count;
+        PyObject * mask = Py_None;
+        PyObject * output = Py_None;
+        PyObject * output_count = Py_None;
+    } args;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "O!I|$OOO",
+        keywords,
+        self->instance->state->Buffer_type,
+        &args.buffer,
+        &args.count,
+        &args.mask,
+        &args.output,
+        &args.output_count
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (!args.count || (VkDeviceSize)args.count * 4 > args.buffer->size) {
+        PyErr_Format(PyExc_ValueError, "count");
+        return NULL;
+    }
+
+    if (!(args.buffer->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+        PyErr_Format(PyExc_ValueError, "buffer");
+        return NULL;
+    }
+
+    Buffer * mask = args.buffer;
+
+    if (args.mask != Py_None) {
+        mask = get_buffer(self->instance, args.mask);
+        if (!mask) {
+            return NULL;
+        }
+        if (!(mask->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) || mask->size < (VkDeviceSize)args.count * 4) {
+            PyErr_Format(PyExc_ValueError, "mask");
+            return NULL;
+        }
+    }
+
+    Buffer * output = get_primitive_buffer(self->instance, args.output, (VkDeviceSize)args.count * 4, "output");
+    if (!output) {
+        return NULL;
+    }
+
+    Buffer * output_count = get_primitive_buffer(self->instance, args.output_count, 4, "output_count");
+    if (!output_count) {
+        Py_DECREF(output);
+        return NULL;
+    }
+
+    uint32_t block_count = get_primitive_block_count(args.count);
+
+    Buffer * partial = new_primitive_buffer(self->instance, block_count * 4);
+
+    PrimitiveParameters parameters = {
+        args.count,
+        0,
+        0,
+        primitive_predicate_flag,
+        0,
+        block_count,
+    };
+
+    bool recorded = record_reduce(self, mask, partial, output_count, parameters);
+
+    if (recorded) {
+        PrimitiveBinding compact_bindings[] = {
+            {"input_buffer", mask},
+            {"input_buffer", partial},
+            {"input_buffer", args.buffer},
+            {"output_buffer", output},
+        };
+
+        recorded = record_primitive(self, compact_primitive, block_count, compact_bindings, 4, parameters);
+    }
+
+    Py_DECREF(partial);
+
+    if (!recorded) {
+        Py_DECREF(output);
+        Py_DECREF(output_count);
+        return NULL;
+    }
+
+    PyObject * res = PyTuple_Pack(2, output, output_count);
+    Py_DECREF(output);
+    Py_DECREF(output_count);
+    return res;
+}
+
+PyObject * Task_meth_sort(Task * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {"buffer", "count", "key_format", "values", NULL};
+
+    struct {
+        Buffer * buffer;
+        uint32_t count;
+        PyObject * key_format;
+        PyObject * values = Py_None;
+    } args;
+
+    args.key_format = self->instance->state->default_primitive_format;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "O!I|$O!O",
+        keywords,
+        self->instance->state->Buffer_type,
+        &args.buffer,
+        &args.count,
+        &PyUnicode_Type,
+        &args.key_format,
+        &args.values
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (!args.count || (VkDeviceSize)args.count * 4 > args.buffer->size) {
+        PyErr_Format(PyExc_ValueError, "count");
+        return NULL;
+    }
+
+    if (!(args.buffer->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)) {
+        PyErr_Format(PyExc_ValueError, "buffer");
+        return NULL;
+    }
+
+    int key_format = get_primitive_format(args.key_format);
+    if (key_format < 0) {
+        PyErr_Format(PyExc_ValueError, "key_format");
+        return NULL;
+    }
+
+    Buffer * values = get_buffer(self->instance, args.values);
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (values && (!(values->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) || values->size < (VkDeviceSize)args.count * 4)) {
+        PyErr_Format(PyExc_ValueError, "values");
+        return NULL;
+    }
+
+    uint32_t block_count = get_primitive_block_count(args.count);
+    uint32_t histogram_count = block_count * 256;
+    uint32_t histogram_block_count = get_primitive_block_count(histogram_count);
+
+    Buffer * key_array[2] = {args.buffer, new_primitive_buffer(self->instance, (VkDeviceSize)args.count * 4)};
+    Buffer * value_array[2] = {values, values ? new_primitive_buffer(self->instance, (VkDeviceSize)args.count * 4) : NULL};
+    Buffer * histogram = new_primitive_buffer(self->instance, (VkDeviceSize)histogram_count * 4);
+    Buffer * offset = new_primitive_buffer(self->instance, (VkDeviceSize)histogram_count * 4);
+    Buffer * partial = new_primitive_buffer(self->instance, histogram_block_count * 4);
+    Buffer * total = new_primitive_buffer(self->instance, 4);
+
+    bool recorded = true;
+
+    // Four stable passes over 8-bit digits, an even number of passes leaves the result in the original buffers.
+    for (uint32_t pass = 0; pass < 4 && recorded; ++pass) {
+        Buffer * keys = key_array[pass % 2];
+        Buffer * sorted_keys = key_array[(pass + 1) % 2];
+        Buffer * pass_values = value_array[pass % 2] ? value_array[pass % 2] : keys;
+        Buffer * sorted_values = value_array[(pass + 1) % 2] ? value_array[(pass + 1) % 2] : sorted_keys;
+
+        PrimitiveParameters parameters = {
+            args.count,
+            (uint32_t)key_format,
+            0,
+            value_array[0] ? primitive_values_flag : 0,
+            pass * 8,
+            block_count,
+        };
+
+        PrimitiveBinding histogram_bindings[] = {
+            {"input_buffer", keys},
+            {"output_buffer", histogram},
+        };
+
+        recorded = record_primitive(self, histogram_primitive, block_count, histogram_bindings, 2, parameters);
+
+        // The digit major histogram scanned gives the first destination of each digit in each block.
+        PrimitiveParameters scan_parameters = {
+            histogram_count,
+            0,
+            0,
+            primitive_exclusive_flag,
+            0,
+            histogram_block_count,
+        };
+
+        recorded = recorded && record_scan(self, histogram, offset, partial, total, scan_parameters);
+
+        PrimitiveBinding scatter_bindings[] = {
+            {"input_buffer", keys},
+            {"input_buffer", offset},
+            {"output_buffer", sorted_keys},
+            {"input_buffer", pass_values},
+            {"output_buffer", sorted_values},
+        };
+
+        recorded = recorded && record_primitive(self, scatter_primitive, block_count, scatter_bindings, 5, parameters);
+    }
+
+    Py_DECREF(key_array[1]);
+    Py_XDECREF(value_array[1]);
+    Py_DECREF(histogram);
+    Py_DECREF(offset);
+    Py_DECREF(partial);
+    Py_DECREF(total);
+
+    if (!recorded) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
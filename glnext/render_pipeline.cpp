@@ -15,6 +15,9 @@ const int indirect_mesh_task_stride = 8;
 const int indirect_indexed_stride = 20;
 const int indirect_stride = 16;
 
+// The first 16 bytes of the push constants are reserved for the layer index.
+const uint32_t push_constant_offset = 16;
+
 void render_mesh_task_indirect_count(RenderPipeline * self, VkCommandBuffer command_buffer) {
     self->instance->vkCmdDrawMeshTasksIndirectCountNV(
         command_buffer,
@@ -66,6 +69,19 @@ void render_indirect_count(RenderPipeline * self, VkCommandBuffer command_buffer
 }
 
 void render_indirect_indexed(RenderPipeline * self, VkCommandBuffer command_buffer) {
+    if (!self->instance->physical_device_features.multiDrawIndirect) {
+        for (uint32_t i = 0; i < self->parameters.indirect_count; ++i) {
+            self->instance->vkCmdDrawIndexedIndirect(
+                command_buffer,
+                self->indirect_buffer->buffer,
+                self->parameters.indirect_buffer_offset + i * indirect_indexed_stride,
+                1,
+                indirect_indexed_stride
+            );
+        }
+        return;
+    }
+
     self->instance->vkCmdDrawIndexedIndirect(
         command_buffer,
         self->indirect_buffer->buffer,
@@ -76,6 +92,19 @@ void render_indirect_indexed(RenderPipeline * self, VkCommandBuffer command_buff
 }
 
 void render_indirect(RenderPipeline * self, VkCommandBuffer command_buffer) {
+    if (!self->instance->physical_device_features.multiDrawIndirect) {
+        for (uint32_t i = 0; i < self->parameters.indirect_count; ++i) {
+            self->instance->vkCmdDrawIndirect(
+                command_buffer,
+                self->indirect_buffer->buffer,
+                self->parameters.indirect_buffer_offset + i * indirect_stride,
+                1,
+                indirect_stride
+            );
+        }
+        return;
+    }
+
     self->instance->vkCmdDrawIndirect(
         command_buffer,
         self->indirect_buffer->buffer,
@@ -93,6 +122,224 @@ void render_simple(RenderPipeline * self, VkCommandBuffer command_buffer) {
     self->instance->vkCmdDraw(command_buffer, self->parameters.vertex_count, self->parameters.instance_count, 0, 0);
 }
 
+int write_draw_list(RenderPipeline * self, PyObject * draw_list) {
+    if (!PyList_Check(draw_list)) {
+        PyErr_Format(PyExc_ValueError, "draw_list");
+        return -1;
+    }
+
+    uint32_t draw_count = (uint32_t)PyList_Size(draw_list);
+    uint32_t stride = self->index_buffer ? indirect_indexed_stride : indirect_stride;
+
+    if (draw_count * stride > self->indirect_buffer->size) {
+        PyErr_Format(PyExc_ValueError, "draw_list");
+        return -1;
+    }
+
+    PyObject * data = PyBytes_FromStringAndSize(NULL, draw_count * stride);
+    uint32_t * ptr = (uint32_t *)PyBytes_AsString(data);
+
+    for (uint32_t i = 0; i < draw_count; ++i) {
+        uint32_t first = 0;
+        uint32_t count = 0;
+        int32_t vertex_offset = 0;
+        uint32_t first_instance = 0;
+        uint32_t instance_count = 1;
+
+        PyObject * item = PyList_GetItem(draw_list, i);
+        if (!PyTuple_Check(item) || !PyArg_ParseTuple(item, "IIi|II", &first, &count, &vertex_offset, &first_instance, &instance_count)) {
+            Py_DECREF(data);
+            PyErr_Format(PyExc_ValueError, "draw_list");
+            return -1;
+        }
+
+        if (self->index_buffer) {
+            VkDrawIndexedIndirectCommand command = {count, instance_count, first, vertex_offset, first_instance};
+            memcpy(ptr, &command, sizeof(command));
+        } else {
+            VkDrawIndirectCommand command = {count, instance_count, first + vertex_offset, first_instance};
+            memcpy(ptr, &command, sizeof(command));
+        }
+
+        ptr += stride / 4;
+    }
+
+    PyObject * res = Buffer_meth_write(self->indirect_buffer, data);
+    Py_DECREF(data);
+
+    if (!res) {
+        return -1;
+    }
+
+    Py_DECREF(res);
+    self->parameters.indirect_count = draw_count;
+    return 0;
+}
+
+bool create_culling_objects(RenderPipeline * self) {
+    Instance * instance = self->instance;
+
+    self->culling_kernel = get_kernel(instance, cull_kernel);
+    if (!self->culling_kernel) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        self->camera[i] = i % 5 ? 0.0f : 1.0f;
+    }
+
+    VkDescriptorPoolSize descriptor_pool_size = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4};
+
+    VkDescriptorPoolCreateInfo descriptor_pool_create_info = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        NULL,
+        0,
+        1,
+        1,
+        &descriptor_pool_size,
+    };
+
+    instance->vkCreateDescriptorPool(instance->device, &descriptor_pool_create_info, NULL, &self->culling_descriptor_pool);
+
+    VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        NULL,
+        self->culling_descriptor_pool,
+        1,
+        &self->culling_kernel->descriptor_set_layout,
+    };
+
+    instance->vkAllocateDescriptorSets(instance->device, &descriptor_set_allocate_info, &self->culling_descriptor_set);
+
+    VkDescriptorBufferInfo descriptor_buffer_info_array[] = {
+        {self->bounds_buffer->buffer, 0, VK_WHOLE_SIZE},
+        {self->instance_buffer->buffer, 0, VK_WHOLE_SIZE},
+        {self->visible_buffer->buffer, 0, VK_WHOLE_SIZE},
+        {self->indirect_buffer->buffer, 0, VK_WHOLE_SIZE},
+    };
+
+    VkWriteDescriptorSet write_descriptor_set = {
+        VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        NULL,
+        self->culling_descriptor_set,
+        0,
+        0,
+        4,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        NULL,
+        descriptor_buffer_info_array,
+        NULL,
+    };
+
+    instance->vkUpdateDescriptorSets(instance->device, 1, &write_descriptor_set, 0, NULL);
+    return true;
+}
+
+void execute_culling(RenderPipeline * self, VkCommandBuffer command_buffer) {
+    Instance * instance = self->instance;
+
+    uint32_t capacity = (uint32_t)(self->bounds_buffer->size / 16);
+    uint32_t instance_count = self->parameters.instance_count < capacity ? self->parameters.instance_count : capacity;
+
+    // The previous draw must finish reading the command and the visible instances before they are rewritten.
+    VkMemoryBarrier memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, NULL, 0, 0};
+
+    instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        1,
+        &memory_barrier,
+        0,
+        NULL,
+        0,
+        NULL
+    );
+
+    if (self->index_buffer) {
+        VkDrawIndexedIndirectCommand command = {self->parameters.index_count, 0, 0, 0, 0};
+        instance->vkCmdUpdateBuffer(command_buffer, self->indirect_buffer->buffer, 0, sizeof(command), &command);
+    } else {
+        VkDrawIndirectCommand command = {self->parameters.vertex_count, 0, 0, 0};
+        instance->vkCmdUpdateBuffer(command_buffer, self->indirect_buffer->buffer, 0, sizeof(command), &command);
+    }
+
+    memory_barrier = {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+    };
+
+    instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        1,
+        &memory_barrier,
+        0,
+        NULL,
+        0,
+        NULL
+    );
+
+    struct {
+        float camera[16];
+        uint32_t instance_count;
+        uint32_t instance_words;
+    } parameters;
+
+    memcpy(parameters.camera, self->camera, sizeof(parameters.camera));
+    parameters.instance_count = instance_count;
+    parameters.instance_words = self->instance_stride / 4;
+
+    instance->vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, self->culling_kernel->pipeline);
+
+    instance->vkCmdBindDescriptorSets(
+        command_buffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        self->culling_kernel->pipeline_layout,
+        0,
+        1,
+        &self->culling_descriptor_set,
+        0,
+        NULL
+    );
+
+    instance->vkCmdPushConstants(
+        command_buffer,
+        self->culling_kernel->pipeline_layout,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        0,
+        sizeof(parameters),
+        &parameters
+    );
+
+    dispatch_kernel_words(instance, command_buffer, instance_count);
+
+    memory_barrier = {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+    };
+
+    instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        0,
+        1,
+        &memory_barrier,
+        0,
+        NULL,
+        0,
+        NULL
+    );
+}
+
 RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, PyObject * kwargs) {
     static char * keywords[] = {
         "vertex_shader",
@@ -121,6 +368,13 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         "short_index",
         "depth_test",
         "depth_write",
+        "specialization",
+        "push_constants",
+        "draw_list",
+        "culling",
+        "subpass",
+        "condition_buffer",
+        "condition_offset",
         "bindings",
         "memory",
         NULL,
@@ -153,6 +407,13 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         VkBool32 short_index = false;
         VkBool32 depth_test = true;
         VkBool32 depth_write = true;
+        PyObject * specialization = Py_None;
+        uint32_t push_constants = 0;
+        PyObject * draw_list = Py_None;
+        VkBool32 culling = false;
+        uint32_t subpass = 0;
+        PyObject * condition_buffer = Py_None;
+        VkDeviceSize condition_offset = 0;
         PyObject * bindings;
         PyObject * memory = Py_None;
     } args;
@@ -165,7 +426,7 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
     int args_ok = PyArg_ParseTupleAndKeywords(
         vargs,
         kwargs,
-        "|$O!O!O!O!OOIIIIIOOOOOKKKKKOppppOO",
+        "|$O!O!O!O!OOIIIIIOOOOOKKKKKOppppOIOpIOKOO",
         keywords,
         &PyBytes_Type,
         &args.vertex_shader,
@@ -197,6 +458,13 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         &args.short_index,
         &args.depth_test,
         &args.depth_write,
+        &args.specialization,
+        &args.push_constants,
+        &args.draw_list,
+        &args.culling,
+        &args.subpass,
+        &args.condition_buffer,
+        &args.condition_offset,
         &args.bindings,
         &args.memory
     );
@@ -205,11 +473,49 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         return NULL;
     }
 
+    if (args.push_constants % 4 || push_constant_offset + args.push_constants > self->instance->physical_device_properties.limits.maxPushConstantsSize) {
+        PyErr_Format(PyExc_ValueError, "push_constants");
+        return NULL;
+    }
+
+    if (args.draw_list != Py_None) {
+        if (!PyList_Check(args.draw_list) || args.indirect_buffer != Py_None || args.mesh_shader != Py_None) {
+            PyErr_Format(PyExc_ValueError, "draw_list");
+            return NULL;
+        }
+
+        // The indirect buffer is owned by the pipeline, its capacity is fixed at max(indirect_count, len(draw_list)).
+        // A longer draw list passed to update is rejected in write_draw_list.
+        uint32_t draw_count = (uint32_t)PyList_Size(args.draw_list);
+        if (args.indirect_count < draw_count) {
+            args.indirect_count = draw_count;
+        }
+        args.indirect_count = args.indirect_count ? args.indirect_count : 1;
+        args.indirect_buffer_offset = 0;
+    }
+
+    if (args.culling) {
+        if (args.instance_buffer != Py_None || args.indirect_buffer != Py_None || args.draw_list != Py_None || args.mesh_shader != Py_None) {
+            PyErr_Format(PyExc_ValueError, "culling");
+            return NULL;
+        }
+
+        // A single indirect draw whose instance count is written by the culling kernel.
+        args.indirect_count = 1;
+        args.indirect_buffer_offset = 0;
+    }
+
+    if (args.subpass >= self->subpass_count) {
+        PyErr_Format(PyExc_ValueError, "subpass");
+        return NULL;
+    }
+
     Memory * memory = get_memory(self->instance, args.memory);
 
     RenderPipeline * res = PyObject_New(RenderPipeline, self->instance->state->RenderPipeline_type);
 
     res->instance = self->instance;
+    res->subpass = args.subpass;
     res->members = PyDict_New();
 
     res->parameters = {
@@ -229,9 +535,18 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
     PyObject * vertex_format = PyUnicode_Split(args.vertex_format, NULL, -1);
     PyObject * instance_format = PyUnicode_Split(args.instance_format, NULL, -1);
 
+    GraphicsPipelineState * state = allocate<GraphicsPipelineState>(1);
+    memset(state, 0, sizeof(GraphicsPipelineState));
+
+    if (!parse_specialization(&state->specialization, args.specialization)) {
+        return NULL;
+    }
+
+    VkSpecializationInfo * specialization_info = state->specialization.info.mapEntryCount ? &state->specialization.info : NULL;
+
     uint32_t attribute_count = 0;
-    VkVertexInputAttributeDescription attribute_array[64];
-    VkVertexInputBindingDescription binding_array[64];
+    VkVertexInputAttributeDescription * attribute_array = state->attribute_array;
+    VkVertexInputBindingDescription * binding_array = state->binding_array;
 
     uint32_t vstride = 0;
     uint32_t istride = 0;
@@ -256,6 +571,11 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         istride += format.size;
     }
 
+    if (args.culling && (!istride || istride % 4)) {
+        PyErr_Format(PyExc_ValueError, "instance_format");
+        return NULL;
+    }
+
     for (uint32_t i = 0; i < vertex_attribute_count; ++i) {
         binding_array[i] = {i, vstride, VK_VERTEX_INPUT_RATE_VERTEX};
     }
@@ -278,11 +598,17 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
     res->index_buffer = get_buffer(self->instance, args.index_buffer);
     res->indirect_buffer = get_buffer(self->instance, args.indirect_buffer);
     res->count_buffer = get_buffer(self->instance, args.count_buffer);
+    res->condition_buffer = get_buffer(self->instance, args.condition_buffer);
+    res->condition_offset = args.condition_offset;
 
     if (PyErr_Occurred()) {
         return NULL;
     }
 
+    if (!check_condition_buffer(self->instance, res->condition_buffer, res->condition_offset)) {
+        return NULL;
+    }
+
     uint32_t indirect_size = indirect_stride;
     uint32_t index_size = args.short_index ? 2 : 4;
 
@@ -305,12 +631,14 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         });
     }
 
+    VkBufferUsageFlags culling_usage = args.culling ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT : 0;
+
     if (istride && !res->instance_buffer) {
         res->instance_buffer = new_buffer({
             self->instance,
             memory,
             istride * args.instance_count,
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | culling_usage,
         });
     }
 
@@ -328,8 +656,33 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
             self->instance,
             memory,
             args.indirect_count * indirect_size,
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | culling_usage,
+        });
+    }
+
+    res->bounds_buffer = NULL;
+    res->visible_buffer = NULL;
+    res->culling_kernel = NULL;
+    res->culling_descriptor_pool = NULL;
+    res->culling_descriptor_set = NULL;
+    res->instance_stride = istride;
+
+    if (args.culling) {
+        res->bounds_buffer = new_buffer({
+            self->instance,
+            memory,
+            16 * args.instance_count,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
         });
+
+        res->visible_buffer = new_buffer({
+            self->instance,
+            memory,
+            istride * args.instance_count,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        });
+
+        PyDict_SetItemString(res->members, "bounds_buffer", (PyObject *)res->bounds_buffer);
     }
 
     if (res->vertex_buffer) {
@@ -374,6 +727,11 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         bind_buffer(res->indirect_buffer);
     }
 
+    if (args.culling) {
+        bind_buffer(res->bounds_buffer);
+        bind_buffer(res->visible_buffer);
+    }
+
     for (uint32_t i = 0; i < res->binding_count; ++i) {
         bind_descriptor_binding_objects(self->instance, &res->binding_array[i]);
     }
@@ -388,8 +746,8 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
     }
 
     for (uint32_t i = vertex_attribute_count; i < attribute_count; ++i) {
-        res->attribute_buffer_array[i] = res->instance_buffer->buffer;
-        res->attribute_offset_array[i] = args.instance_buffer_offset;
+        res->attribute_buffer_array[i] = args.culling ? res->visible_buffer->buffer : res->instance_buffer->buffer;
+        res->attribute_offset_array[i] = args.culling ? 0 : args.instance_buffer_offset;
     }
 
     res->descriptor_binding_array = (VkDescriptorSetLayoutBinding *)PyMem_Malloc(sizeof(VkDescriptorSetLayoutBinding) * res->binding_count);
@@ -402,40 +760,31 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         res->write_descriptor_set_array[i] = res->binding_array[i].write_descriptor_set;
     }
 
+    res->dynamic_offset_array = allocate<uint32_t>(res->binding_count);
+
+    res->push_constant_size = args.push_constants;
+    res->push_constant_data = allocate<char>(args.push_constants);
+    memset(res->push_constant_data, 0, args.push_constants);
+
     VkPushConstantRange push_constant_range = {
         VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
         0,
-        4,
+        args.push_constants ? push_constant_offset + args.push_constants : 4,
     };
 
-    VkPipelineLayoutCreateInfo pipeline_layout_create_info = {
-        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        NULL,
-        0,
-        0,
-        NULL,
-        1,
-        &push_constant_range,
-    };
+    PipelineLayout * pipeline_layout = get_pipeline_layout(
+        self->instance,
+        res->binding_count,
+        res->descriptor_binding_array,
+        &push_constant_range
+    );
 
-    res->descriptor_set_layout = NULL;
+    res->descriptor_set_layout = pipeline_layout->descriptor_set_layout;
+    res->pipeline_layout = pipeline_layout->pipeline_layout;
     res->descriptor_pool = NULL;
     res->descriptor_set = NULL;
 
     if (res->binding_count) {
-        VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info = {
-            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-            NULL,
-            0,
-            res->binding_count,
-            res->descriptor_binding_array,
-        };
-
-        self->instance->vkCreateDescriptorSetLayout(self->instance->device, &descriptor_set_layout_create_info, NULL, &res->descriptor_set_layout);
-
-        pipeline_layout_create_info.setLayoutCount = 1;
-        pipeline_layout_create_info.pSetLayouts = &res->descriptor_set_layout;
-
         VkDescriptorPoolCreateInfo descriptor_pool_create_info = {
             VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
             NULL,
@@ -470,22 +819,11 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         );
     }
 
-    self->instance->vkCreatePipelineLayout(self->instance->device, &pipeline_layout_create_info, NULL, &res->pipeline_layout);
-
     uint32_t pipeline_shader_stage_count = 0;
-    VkPipelineShaderStageCreateInfo pipeline_shader_stage_array[8] = {};
+    VkPipelineShaderStageCreateInfo * pipeline_shader_stage_array = state->shader_stage_array;
 
     if (args.vertex_shader != Py_None) {
-        VkShaderModuleCreateInfo vertex_shader_module_create_info = {
-            VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            NULL,
-            0,
-            (VkDeviceSize)PyBytes_Size(args.vertex_shader),
-            (uint32_t *)PyBytes_AsString(args.vertex_shader),
-        };
-
-        VkShaderModule vertex_shader_module = NULL;
-        self->instance->vkCreateShaderModule(self->instance->device, &vertex_shader_module_create_info, NULL, &vertex_shader_module);
+        VkShaderModule vertex_shader_module = get_shader_module(self->instance, args.vertex_shader);
 
         pipeline_shader_stage_array[pipeline_shader_stage_count++] = {
             VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
@@ -494,21 +832,12 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
             VK_SHADER_STAGE_VERTEX_BIT,
             vertex_shader_module,
             "main",
-            NULL,
+            specialization_info,
         };
     }
 
     if (args.fragment_shader != Py_None) {
-        VkShaderModuleCreateInfo fragment_shader_module_create_info = {
-            VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            NULL,
-            0,
-            (VkDeviceSize)PyBytes_Size(args.fragment_shader),
-            (uint32_t *)PyBytes_AsString(args.fragment_shader),
-        };
-
-        VkShaderModule fragment_shader_module = NULL;
-        self->instance->vkCreateShaderModule(self->instance->device, &fragment_shader_module_create_info, NULL, &fragment_shader_module);
+        VkShaderModule fragment_shader_module = get_shader_module(self->instance, args.fragment_shader);
 
         pipeline_shader_stage_array[pipeline_shader_stage_count++] = {
             VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
@@ -517,21 +846,12 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
             VK_SHADER_STAGE_FRAGMENT_BIT,
             fragment_shader_module,
             "main",
-            NULL,
+            specialization_info,
         };
     }
 
     if (args.mesh_shader != Py_None) {
-        VkShaderModuleCreateInfo mesh_shader_module_create_info = {
-            VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            NULL,
-            0,
-            (VkDeviceSize)PyBytes_Size(args.mesh_shader),
-            (uint32_t *)PyBytes_AsString(args.mesh_shader),
-        };
-
-        VkShaderModule mesh_shader_module = NULL;
-        self->instance->vkCreateShaderModule(self->instance->device, &mesh_shader_module_create_info, NULL, &mesh_shader_module);
+        VkShaderModule mesh_shader_module = get_shader_module(self->instance, args.mesh_shader);
 
         pipeline_shader_stage_array[pipeline_shader_stage_count++] = {
             VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
@@ -540,11 +860,11 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
             VK_SHADER_STAGE_MESH_BIT_NV,
             mesh_shader_module,
             "main",
-            NULL,
+            specialization_info,
         };
     }
 
-    VkPipelineVertexInputStateCreateInfo pipeline_vertex_input_state = {
+    state->vertex_input_state = {
         VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
         NULL,
         0,
@@ -567,7 +887,7 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         }
     }
 
-    VkPipelineInputAssemblyStateCreateInfo pipeline_input_assembly_state = {
+    state->input_assembly_state = {
         VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
         NULL,
         0,
@@ -575,7 +895,7 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         restart_index,
     };
 
-    VkPipelineViewportStateCreateInfo pipeline_viewport_state = {
+    state->viewport_state = {
         VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
         NULL,
         0,
@@ -585,7 +905,7 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         NULL,
     };
 
-    VkPipelineRasterizationStateCreateInfo pipeline_rasterization_state = {
+    state->rasterization_state = {
         VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
         NULL,
         0,
@@ -601,7 +921,7 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         1.0f,
     };
 
-    VkPipelineMultisampleStateCreateInfo pipeline_multisample_state = {
+    state->multisample_state = {
         VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
         NULL,
         0,
@@ -613,7 +933,7 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         false,
     };
 
-    VkPipelineDepthStencilStateCreateInfo pipeline_depth_stencil_state = {
+    state->depth_stencil_state = {
         VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
         NULL,
         0,
@@ -628,8 +948,8 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         0.0f,
     };
 
-    uint32_t color_attachment_count = (uint32_t)PyTuple_Size(self->output);
-    VkPipelineColorBlendAttachmentState pipeline_color_blend_attachment_array[64];
+    uint32_t color_attachment_count = self->subpass_output_count_array[args.subpass];
+    VkPipelineColorBlendAttachmentState * pipeline_color_blend_attachment_array = state->color_blend_attachment_array;
 
     for (uint32_t i = 0; i < color_attachment_count; ++i) {
         pipeline_color_blend_attachment_array[i] = {
@@ -644,7 +964,7 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         };
     }
 
-    VkPipelineColorBlendStateCreateInfo pipeline_color_blend_state = {
+    state->color_blend_state = {
         VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
         NULL,
         0,
@@ -655,9 +975,11 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         {0.0f, 0.0f, 0.0f, 0.0f},
     };
 
-    VkDynamicState dynamic_state_array[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkDynamicState * dynamic_state_array = state->dynamic_state_array;
+    dynamic_state_array[0] = VK_DYNAMIC_STATE_VIEWPORT;
+    dynamic_state_array[1] = VK_DYNAMIC_STATE_SCISSOR;
 
-    VkPipelineDynamicStateCreateInfo pipeline_dynamic_state = {
+    state->dynamic_state = {
         VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
         NULL,
         0,
@@ -665,32 +987,62 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         dynamic_state_array,
     };
 
-    VkGraphicsPipelineCreateInfo pipeline_create_info = {
-        VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+    for (uint32_t i = 0; i < color_attachment_count; ++i) {
+        state->color_format_array[i] = self->image_array[i]->format;
+    }
+
+    state->rendering = {
+        VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
         NULL,
+        self->multiview ? get_view_mask(self->layers) : 0,
+        color_attachment_count,
+        state->color_format_array,
+        self->depth ? self->instance->depth_format : VK_FORMAT_UNDEFINED,
+        VK_FORMAT_UNDEFINED,
+    };
+
+    state->pipeline_create_info = {
+        VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        self->dynamic ? &state->rendering : NULL,
         0,
         pipeline_shader_stage_count,
         pipeline_shader_stage_array,
-        &pipeline_vertex_input_state,
-        &pipeline_input_assembly_state,
+        &state->vertex_input_state,
+        &state->input_assembly_state,
         NULL,
-        &pipeline_viewport_state,
-        &pipeline_rasterization_state,
-        &pipeline_multisample_state,
-        &pipeline_depth_stencil_state,
-        &pipeline_color_blend_state,
-        &pipeline_dynamic_state,
+        &state->viewport_state,
+        &state->rasterization_state,
+        &state->multisample_state,
+        &state->depth_stencil_state,
+        &state->color_blend_state,
+        &state->dynamic_state,
         res->pipeline_layout,
         self->render_pass,
-        0,
+        args.subpass,
         NULL,
         0,
     };
 
-    self->instance->vkCreateGraphicsPipelines(self->instance->device, self->instance->pipeline_cache, 1, &pipeline_create_info, NULL, &res->pipeline);
+    state->shader_stage_count = pipeline_shader_stage_count;
+
+    res->pipeline = NULL;
+    res->pipeline_state = state;
 
-    for (uint32_t i = 0; i < pipeline_shader_stage_count; ++i) {
-        self->instance->vkDestroyShaderModule(self->instance->device, pipeline_shader_stage_array[i].module, NULL);
+    if (self->instance->deferred) {
+        PyList_Append(self->instance->pending_list, (PyObject *)res);
+    } else {
+        PyObject * key = get_pipeline_key(state);
+        PyObject * cached = PyDict_GetItem(self->instance->pipeline_dict, key);
+        if (cached) {
+            res->pipeline = (VkPipeline)PyLong_AsVoidPtr(cached);
+        } else {
+            res->pipeline = create_graphics_pipeline(self->instance, state);
+            PyObject * ptr = PyLong_FromVoidPtr(res->pipeline);
+            PyDict_SetItem(self->instance->pipeline_dict, key, ptr);
+            Py_DECREF(ptr);
+        }
+        Py_DECREF(key);
+        release_pipeline_state(res);
     }
 
     if (args.mesh_shader != Py_None) {
@@ -725,10 +1077,273 @@ RenderPipeline * Framebuffer_meth_render(Framebuffer * self, PyObject * vargs, P
         }
     }
 
+    if (args.draw_list != Py_None) {
+        if (write_draw_list(res, args.draw_list)) {
+            return NULL;
+        }
+    }
+
+    if (args.culling && !create_culling_objects(res)) {
+        return NULL;
+    }
+
     PyList_Append(self->render_pipeline_list, (PyObject *)res);
     return res;
 }
 
+void append_specialization_key(PyObject * key, const VkSpecializationInfo * info) {
+    uint32_t count = info ? info->mapEntryCount : 0;
+    append_key(key, &count, sizeof(uint32_t));
+    if (count) {
+        append_key(key, info->pMapEntries, sizeof(VkSpecializationMapEntry) * count);
+        append_key(key, info->pData, info->dataSize);
+    }
+}
+
+void append_stage_key(PyObject * key, GraphicsPipelineState * state, VkShaderStageFlags stages) {
+    for (uint32_t i = 0; i < state->shader_stage_count; ++i) {
+        if (state->shader_stage_array[i].stage & stages) {
+            append_key(key, &state->shader_stage_array[i].stage, sizeof(VkShaderStageFlagBits));
+            append_key(key, &state->shader_stage_array[i].module, sizeof(VkShaderModule));
+            append_specialization_key(key, state->shader_stage_array[i].pSpecializationInfo);
+        }
+    }
+}
+
+void append_render_pass_key(PyObject * key, GraphicsPipelineState * state) {
+    VkGraphicsPipelineCreateInfo * info = &state->pipeline_create_info;
+    append_key(key, &info->renderPass, sizeof(info->renderPass));
+    append_key(key, &info->subpass, sizeof(info->subpass));
+
+    if (!info->renderPass) {
+        VkPipelineRenderingCreateInfoKHR * rendering = &state->rendering;
+        append_key(key, &rendering->viewMask, sizeof(uint32_t));
+        append_key(key, &rendering->colorAttachmentCount, sizeof(uint32_t));
+        append_key(key, rendering->pColorAttachmentFormats, sizeof(VkFormat) * rendering->colorAttachmentCount);
+        append_key(key, &rendering->depthAttachmentFormat, sizeof(VkFormat));
+    }
+}
+
+void append_vertex_input_key(PyObject * key, GraphicsPipelineState * state) {
+    VkPipelineVertexInputStateCreateInfo * vertex_input = &state->vertex_input_state;
+    append_key(key, &vertex_input->vertexBindingDescriptionCount, sizeof(uint32_t));
+    append_key(key, vertex_input->pVertexBindingDescriptions, sizeof(VkVertexInputBindingDescription) * vertex_input->vertexBindingDescriptionCount);
+    append_key(key, &vertex_input->vertexAttributeDescriptionCount, sizeof(uint32_t));
+    append_key(key, vertex_input->pVertexAttributeDescriptions, sizeof(VkVertexInputAttributeDescription) * vertex_input->vertexAttributeDescriptionCount);
+
+    append_key(key, &state->input_assembly_state.topology, sizeof(VkPrimitiveTopology));
+    append_key(key, &state->input_assembly_state.primitiveRestartEnable, sizeof(VkBool32));
+}
+
+void append_pre_rasterization_key(PyObject * key, GraphicsPipelineState * state) {
+    VkGraphicsPipelineCreateInfo * info = &state->pipeline_create_info;
+    append_key(key, &info->layout, sizeof(info->layout));
+    append_render_pass_key(key, state);
+
+    append_stage_key(key, state, ~VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    VkPipelineRasterizationStateCreateInfo * rasterization = &state->rasterization_state;
+    append_key(key, &rasterization->depthClampEnable, sizeof(*rasterization) - offsetof(VkPipelineRasterizationStateCreateInfo, depthClampEnable));
+
+    append_key(key, &state->dynamic_state.dynamicStateCount, sizeof(uint32_t));
+    append_key(key, state->dynamic_state.pDynamicStates, sizeof(VkDynamicState) * state->dynamic_state.dynamicStateCount);
+}
+
+void append_fragment_shader_key(PyObject * key, GraphicsPipelineState * state) {
+    VkGraphicsPipelineCreateInfo * info = &state->pipeline_create_info;
+    append_key(key, &info->layout, sizeof(info->layout));
+    append_render_pass_key(key, state);
+
+    append_stage_key(key, state, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    append_key(key, &state->multisample_state.rasterizationSamples, sizeof(VkSampleCountFlagBits));
+
+    VkPipelineDepthStencilStateCreateInfo * depth_stencil = &state->depth_stencil_state;
+    append_key(key, &depth_stencil->depthTestEnable, sizeof(*depth_stencil) - offsetof(VkPipelineDepthStencilStateCreateInfo, depthTestEnable));
+}
+
+void append_fragment_output_key(PyObject * key, GraphicsPipelineState * state) {
+    append_render_pass_key(key, state);
+
+    append_key(key, &state->multisample_state.rasterizationSamples, sizeof(VkSampleCountFlagBits));
+
+    VkPipelineColorBlendStateCreateInfo * color_blend = &state->color_blend_state;
+    append_key(key, &color_blend->logicOpEnable, sizeof(VkBool32));
+    append_key(key, &color_blend->logicOp, sizeof(VkLogicOp));
+    append_key(key, &color_blend->attachmentCount, sizeof(uint32_t));
+    append_key(key, color_blend->pAttachments, sizeof(VkPipelineColorBlendAttachmentState) * color_blend->attachmentCount);
+}
+
+PyObject * get_pipeline_key(GraphicsPipelineState * state) {
+    PyObject * key = PyByteArray_FromStringAndSize(NULL, 0);
+    append_vertex_input_key(key, state);
+    append_pre_rasterization_key(key, state);
+    append_fragment_shader_key(key, state);
+    append_fragment_output_key(key, state);
+    return finish_key(key);
+}
+
+PyObject * get_pipeline_library_key(GraphicsPipelineState * state, VkGraphicsPipelineLibraryFlagsEXT part) {
+    PyObject * key = PyByteArray_FromStringAndSize(NULL, 0);
+    append_key(key, &part, sizeof(part));
+
+    switch (part) {
+        case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+            append_vertex_input_key(key, state);
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+            append_pre_rasterization_key(key, state);
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+            append_fragment_shader_key(key, state);
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+            append_fragment_output_key(key, state);
+            break;
+    }
+
+    return finish_key(key);
+}
+
+void fill_pipeline_library(PipelineLibraryState * library, GraphicsPipelineState * state, VkGraphicsPipelineLibraryFlagsEXT part) {
+    library->library_create_info = {
+        VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+        (void *)state->pipeline_create_info.pNext,
+        part,
+    };
+
+    // Each part only reads the state that belongs to it, the rest is left out.
+    library->pipeline_create_info = {
+        VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        &library->library_create_info,
+        VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
+    };
+
+    VkGraphicsPipelineCreateInfo * pipeline_create_info = &library->pipeline_create_info;
+    uint32_t shader_stage_count = 0;
+
+    switch (part) {
+        case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+            pipeline_create_info->pVertexInputState = &state->vertex_input_state;
+            pipeline_create_info->pInputAssemblyState = &state->input_assembly_state;
+            break;
+
+        case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+            for (uint32_t i = 0; i < state->shader_stage_count; ++i) {
+                if (state->shader_stage_array[i].stage != VK_SHADER_STAGE_FRAGMENT_BIT) {
+                    library->shader_stage_array[shader_stage_count++] = state->shader_stage_array[i];
+                }
+            }
+            pipeline_create_info->pViewportState = &state->viewport_state;
+            pipeline_create_info->pRasterizationState = &state->rasterization_state;
+            pipeline_create_info->pDynamicState = &state->dynamic_state;
+            pipeline_create_info->layout = state->pipeline_create_info.layout;
+            pipeline_create_info->renderPass = state->pipeline_create_info.renderPass;
+            pipeline_create_info->subpass = state->pipeline_create_info.subpass;
+            break;
+
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+            for (uint32_t i = 0; i < state->shader_stage_count; ++i) {
+                if (state->shader_stage_array[i].stage == VK_SHADER_STAGE_FRAGMENT_BIT) {
+                    library->shader_stage_array[shader_stage_count++] = state->shader_stage_array[i];
+                }
+            }
+            pipeline_create_info->pMultisampleState = &state->multisample_state;
+            pipeline_create_info->pDepthStencilState = &state->depth_stencil_state;
+            pipeline_create_info->layout = state->pipeline_create_info.layout;
+            pipeline_create_info->renderPass = state->pipeline_create_info.renderPass;
+            pipeline_create_info->subpass = state->pipeline_create_info.subpass;
+            break;
+
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+            pipeline_create_info->pMultisampleState = &state->multisample_state;
+            pipeline_create_info->pColorBlendState = &state->color_blend_state;
+            pipeline_create_info->renderPass = state->pipeline_create_info.renderPass;
+            pipeline_create_info->subpass = state->pipeline_create_info.subpass;
+            break;
+    }
+
+    pipeline_create_info->stageCount = shader_stage_count;
+    pipeline_create_info->pStages = library->shader_stage_array;
+}
+
+VkPipeline get_pipeline_library(Instance * self, GraphicsPipelineState * state, VkGraphicsPipelineLibraryFlagsEXT part) {
+    PyObject * key = get_pipeline_library_key(state, part);
+
+    PyObject * cached = PyDict_GetItem(self->library_dict, key);
+    if (cached) {
+        Py_DECREF(key);
+        return (VkPipeline)PyLong_AsVoidPtr(cached);
+    }
+
+    PipelineLibraryState library;
+    fill_pipeline_library(&library, state, part);
+
+    VkPipeline pipeline = NULL;
+    self->vkCreateGraphicsPipelines(self->device, self->pipeline_cache, 1, &library.pipeline_create_info, NULL, &pipeline);
+
+    PyObject * ptr = PyLong_FromVoidPtr(pipeline);
+    PyDict_SetItem(self->library_dict, key, ptr);
+    Py_DECREF(ptr);
+    Py_DECREF(key);
+    return pipeline;
+}
+
+bool use_pipeline_library(Instance * self, GraphicsPipelineState * state) {
+    if (!self->extension.graphics_pipeline_library) {
+        return false;
+    }
+
+    // Mesh shading pipelines are not split into parts.
+    for (uint32_t i = 0; i < state->shader_stage_count; ++i) {
+        if (state->shader_stage_array[i].stage == VK_SHADER_STAGE_MESH_BIT_NV) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+VkPipeline create_graphics_pipeline(Instance * self, GraphicsPipelineState * state) {
+    VkPipeline pipeline = NULL;
+
+    if (!use_pipeline_library(self, state)) {
+        self->vkCreateGraphicsPipelines(self->device, self->pipeline_cache, 1, &state->pipeline_create_info, NULL, &pipeline);
+        return pipeline;
+    }
+
+    VkPipeline library_array[] = {
+        get_pipeline_library(self, state, VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT),
+        get_pipeline_library(self, state, VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT),
+        get_pipeline_library(self, state, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT),
+        get_pipeline_library(self, state, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT),
+    };
+
+    VkPipelineLibraryCreateInfoKHR library_create_info = {
+        VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        NULL,
+        4,
+        library_array,
+    };
+
+    // Fast link without link time optimization, the parts are already compiled.
+    VkGraphicsPipelineCreateInfo pipeline_create_info = {
+        VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        &library_create_info,
+        0,
+    };
+
+    pipeline_create_info.layout = state->pipeline_create_info.layout;
+
+    self->vkCreateGraphicsPipelines(self->device, self->pipeline_cache, 1, &pipeline_create_info, NULL, &pipeline);
+    return pipeline;
+}
+
+void release_pipeline_state(RenderPipeline * self) {
+    PyMem_Free(self->pipeline_state);
+    self->pipeline_state = NULL;
+}
+
 PyObject * RenderPipeline_meth_update(RenderPipeline * self, PyObject * vargs, PyObject * kwargs) {
     if (PyTuple_Size(vargs) || !kwargs) {
         PyErr_Format(PyExc_TypeError, "invalid arguments");
@@ -767,6 +1382,50 @@ PyObject * RenderPipeline_meth_update(RenderPipeline * self, PyObject * vargs, P
             }
             continue;
         }
+        if (!PyUnicode_CompareWithASCIIString(key, "camera")) {
+            Py_buffer view = {};
+            if (PyObject_GetBuffer(value, &view, PyBUF_STRIDED_RO)) {
+                return NULL;
+            }
+            if (view.len != sizeof(self->camera)) {
+                PyBuffer_Release(&view);
+                PyErr_Format(PyExc_ValueError, "wrong size");
+                return NULL;
+            }
+            PyBuffer_ToContiguous(self->camera, &view, view.len, 'C');
+            PyBuffer_Release(&view);
+            continue;
+        }
+        if (!PyUnicode_CompareWithASCIIString(key, "draw_list")) {
+            if (!self->indirect_buffer || write_draw_list(self, value)) {
+                if (!PyErr_Occurred()) {
+                    PyErr_Format(PyExc_ValueError, "draw_list");
+                }
+                return NULL;
+            }
+            continue;
+        }
+        if (!PyUnicode_CompareWithASCIIString(key, "push_constants")) {
+            Py_buffer view = {};
+            if (PyObject_GetBuffer(value, &view, PyBUF_STRIDED_RO)) {
+                return NULL;
+            }
+            if ((uint32_t)view.len != self->push_constant_size) {
+                PyBuffer_Release(&view);
+                PyErr_Format(PyExc_ValueError, "wrong size");
+                return NULL;
+            }
+            PyBuffer_ToContiguous(self->push_constant_data, &view, view.len, 'C');
+            PyBuffer_Release(&view);
+            continue;
+        }
+        int dynamic = write_dynamic_binding(self->instance, self->binding_count, self->binding_array, key, value);
+        if (dynamic < 0) {
+            return NULL;
+        }
+        if (dynamic) {
+            continue;
+        }
         PyObject * member = PyDict_GetItem(self->members, key);
         if (!member) {
             return NULL;
@@ -781,14 +1440,49 @@ PyObject * RenderPipeline_meth_update(RenderPipeline * self, PyObject * vargs, P
     Py_RETURN_NONE;
 }
 
-void execute_render_pipeline(RenderPipeline * self, VkCommandBuffer command_buffer) {
+void execute_render_pipeline(RenderPipeline * self, VkCommandBuffer command_buffer, RenderState * state) {
     if (!self->parameters.enabled) {
         return;
     }
 
-    self->instance->vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, self->pipeline);
+    // Binds identical to the previous draw of the same render pass are skipped.
+    if (state->pipeline != self->pipeline) {
+        self->instance->vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, self->pipeline);
+        state->pipeline = self->pipeline;
+    }
+
+    if (state->pipeline_layout != self->pipeline_layout) {
+        self->instance->vkCmdPushConstants(
+            command_buffer,
+            self->pipeline_layout,
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            0,
+            4,
+            &state->layer
+        );
+        state->pipeline_layout = self->pipeline_layout;
+        state->descriptor_set = NULL;
+    }
+
+    if (self->push_constant_size) {
+        self->instance->vkCmdPushConstants(
+            command_buffer,
+            self->pipeline_layout,
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            push_constant_offset,
+            self->push_constant_size,
+            self->push_constant_data
+        );
+    }
+
+    bool same_attributes = state->attribute_count == self->attribute_count && (
+        !self->attribute_count || (
+            !memcmp(state->attribute_buffer_array, self->attribute_buffer_array, sizeof(VkBuffer) * self->attribute_count) &&
+            !memcmp(state->attribute_offset_array, self->attribute_offset_array, sizeof(VkDeviceSize) * self->attribute_count)
+        )
+    );
 
-    if (self->attribute_count) {
+    if (self->attribute_count && !same_attributes) {
         self->instance->vkCmdBindVertexBuffers(
             command_buffer,
             0,
@@ -796,31 +1490,51 @@ void execute_render_pipeline(RenderPipeline * self, VkCommandBuffer command_buff
             self->attribute_buffer_array,
             self->attribute_offset_array
         );
+        state->attribute_count = self->attribute_count;
+        state->attribute_buffer_array = self->attribute_buffer_array;
+        state->attribute_offset_array = self->attribute_offset_array;
     }
 
     if (self->descriptor_set) {
-        self->instance->vkCmdBindDescriptorSets(
-            command_buffer,
-            VK_PIPELINE_BIND_POINT_GRAPHICS,
-            self->pipeline_layout,
-            0,
-            1,
-            &self->descriptor_set,
-            0,
-            NULL
-        );
+        uint32_t dynamic_offset_count = get_dynamic_offsets(self->binding_count, self->binding_array, self->dynamic_offset_array);
+        if (state->descriptor_set != self->descriptor_set || dynamic_offset_count) {
+            self->instance->vkCmdBindDescriptorSets(
+                command_buffer,
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                self->pipeline_layout,
+                0,
+                1,
+                &self->descriptor_set,
+                dynamic_offset_count,
+                self->dynamic_offset_array
+            );
+            state->descriptor_set = self->descriptor_set;
+        }
     }
 
     if (self->index_buffer) {
-        self->instance->vkCmdBindIndexBuffer(
-            command_buffer,
-            self->index_buffer->buffer,
-            self->parameters.index_buffer_offset,
-            self->index_type
-        );
+        if (state->index_buffer != self->index_buffer->buffer || state->index_buffer_offset != self->parameters.index_buffer_offset || state->index_type != self->index_type) {
+            self->instance->vkCmdBindIndexBuffer(
+                command_buffer,
+                self->index_buffer->buffer,
+                self->parameters.index_buffer_offset,
+                self->index_type
+            );
+            state->index_buffer = self->index_buffer->buffer;
+            state->index_buffer_offset = self->parameters.index_buffer_offset;
+            state->index_type = self->index_type;
+        }
+    }
+
+    if (self->condition_buffer) {
+        begin_conditional_rendering(self->instance, command_buffer, self->condition_buffer, self->condition_offset);
     }
 
     self->render_command(self, command_buffer);
+
+    if (self->condition_buffer) {
+        self->instance->vkCmdEndConditionalRenderingEXT(command_buffer);
+    }
 }
 
 PyObject * RenderPipeline_subscript(RenderPipeline * self, PyObject * key) {
@@ -9,17 +9,30 @@ Task * Instance_meth_task(Instance * self) {
 }
 
 PyObject * Task_meth_run(Task * self) {
+    compile_pipelines(self->instance);
+
     if (!self->instance->group) {
         begin_commands(self->instance);
     }
 
+    ComputeState state = {};
+
+    // Commands recorded earlier in the group may write resources of this task.
+    if (self->instance->group) {
+        state.pending_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        state.pending_access = VK_ACCESS_MEMORY_WRITE_BIT;
+    }
+
     for (uint32_t i = 0; i < PyList_Size(self->task_list); ++i) {
         PyObject * obj = PyList_GetItem(self->task_list, i);
         if (Py_TYPE(obj) == self->instance->state->Framebuffer_type) {
+            flush_compute_state(self->instance, self->instance->command_buffer, &state);
             execute_framebuffer((Framebuffer *)obj, self->instance->command_buffer);
+            state.pending_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            state.pending_access = VK_ACCESS_MEMORY_WRITE_BIT;
         }
         if (Py_TYPE(obj) == self->instance->state->ComputePipeline_type) {
-            execute_compute_pipeline((ComputePipeline *)obj, self->instance->command_buffer);
+            execute_compute_pipeline((ComputePipeline *)obj, self->instance->command_buffer, &state);
         }
     }
 
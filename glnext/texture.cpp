@@ -0,0 +1,459 @@
+#include "glnext.hpp"
+
+struct TextureFormat {
+    uint32_t dxgi_format;
+    VkFormat format;
+    uint32_t block_size;
+    uint32_t block_extent;
+};
+
+struct TextureRegion {
+    VkDeviceSize file_offset;
+    VkDeviceSize size;
+    VkBufferImageCopy copy;
+};
+
+struct TextureInfo {
+    TextureFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levels;
+    uint32_t layers;
+    uint32_t region_count;
+    TextureRegion * region_array;
+};
+
+const TextureFormat texture_format_array[] = {
+    {2, VK_FORMAT_R32G32B32A32_SFLOAT, 16, 1},
+    {10, VK_FORMAT_R16G16B16A16_SFLOAT, 8, 1},
+    {11, VK_FORMAT_R16G16B16A16_UNORM, 8, 1},
+    {16, VK_FORMAT_R32G32_SFLOAT, 8, 1},
+    {24, VK_FORMAT_A2B10G10R10_UNORM_PACK32, 4, 1},
+    {26, VK_FORMAT_B10G11R11_UFLOAT_PACK32, 4, 1},
+    {28, VK_FORMAT_R8G8B8A8_UNORM, 4, 1},
+    {29, VK_FORMAT_R8G8B8A8_SRGB, 4, 1},
+    {34, VK_FORMAT_R16G16_SFLOAT, 4, 1},
+    {41, VK_FORMAT_R32_SFLOAT, 4, 1},
+    {49, VK_FORMAT_R8G8_UNORM, 2, 1},
+    {54, VK_FORMAT_R16_SFLOAT, 2, 1},
+    {61, VK_FORMAT_R8_UNORM, 1, 1},
+    {71, VK_FORMAT_BC1_RGBA_UNORM_BLOCK, 8, 4},
+    {72, VK_FORMAT_BC1_RGBA_SRGB_BLOCK, 8, 4},
+    {74, VK_FORMAT_BC2_UNORM_BLOCK, 16, 4},
+    {75, VK_FORMAT_BC2_SRGB_BLOCK, 16, 4},
+    {77, VK_FORMAT_BC3_UNORM_BLOCK, 16, 4},
+    {78, VK_FORMAT_BC3_SRGB_BLOCK, 16, 4},
+    {80, VK_FORMAT_BC4_UNORM_BLOCK, 8, 4},
+    {81, VK_FORMAT_BC4_SNORM_BLOCK, 8, 4},
+    {83, VK_FORMAT_BC5_UNORM_BLOCK, 16, 4},
+    {84, VK_FORMAT_BC5_SNORM_BLOCK, 16, 4},
+    {87, VK_FORMAT_B8G8R8A8_UNORM, 4, 1},
+    {91, VK_FORMAT_B8G8R8A8_SRGB, 4, 1},
+    {95, VK_FORMAT_BC6H_UFLOAT_BLOCK, 16, 4},
+    {96, VK_FORMAT_BC6H_SFLOAT_BLOCK, 16, 4},
+    {98, VK_FORMAT_BC7_UNORM_BLOCK, 16, 4},
+    {99, VK_FORMAT_BC7_SRGB_BLOCK, 16, 4},
+    {0, VK_FORMAT_BC1_RGB_UNORM_BLOCK, 8, 4},
+    {0, VK_FORMAT_BC1_RGB_SRGB_BLOCK, 8, 4},
+    {0, VK_FORMAT_R8G8B8A8_UINT, 4, 1},
+    {0, VK_FORMAT_R16G16B16A16_UINT, 8, 1},
+    {0, VK_FORMAT_R32G32B32A32_UINT, 16, 1},
+    {0, VK_FORMAT_R32G32B32_SFLOAT, 12, 1},
+    {0, VK_FORMAT_R8G8B8_UNORM, 3, 1},
+    {0, VK_FORMAT_R8G8B8_SRGB, 3, 1},
+    {0, VK_FORMAT_R8G8_SRGB, 2, 1},
+    {0, VK_FORMAT_R8_SRGB, 1, 1},
+    {0, VK_FORMAT_E5B9G9R9_UFLOAT_PACK32, 4, 1},
+};
+
+const uint32_t texture_format_count = sizeof(texture_format_array) / sizeof(TextureFormat);
+
+const uint8_t ktx2_identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+constexpr uint32_t fourcc(const char * code) {
+    return (uint32_t)code[0] | (uint32_t)code[1] << 8 | (uint32_t)code[2] << 16 | (uint32_t)code[3] << 24;
+}
+
+bool find_texture_format(TextureFormat * res, VkFormat format, uint32_t dxgi_format) {
+    for (uint32_t i = 0; i < texture_format_count; ++i) {
+        if (format ? texture_format_array[i].format == format : dxgi_format && texture_format_array[i].dxgi_format == dxgi_format) {
+            *res = texture_format_array[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+VkDeviceSize texture_level_size(TextureFormat format, uint32_t width, uint32_t height, uint32_t level) {
+    uint32_t w = width >> level ? width >> level : 1;
+    uint32_t h = height >> level ? height >> level : 1;
+    VkDeviceSize columns = (w + format.block_extent - 1) / format.block_extent;
+    VkDeviceSize rows = (h + format.block_extent - 1) / format.block_extent;
+    return columns * rows * format.block_size;
+}
+
+void set_texture_region(TextureInfo * info, uint32_t index, VkDeviceSize offset, VkDeviceSize size, uint32_t level, uint32_t layer, uint32_t layers) {
+    uint32_t width = info->width >> level ? info->width >> level : 1;
+    uint32_t height = info->height >> level ? info->height >> level : 1;
+    info->region_array[index] = {
+        offset,
+        size,
+        {
+            0,
+            0,
+            0,
+            {VK_IMAGE_ASPECT_COLOR_BIT, level, layer, layers},
+            {0, 0, 0},
+            {width, height, 1},
+        },
+    };
+}
+
+bool parse_ktx2(const uint8_t * data, size_t size, TextureInfo * info) {
+    if (size < 80 || memcmp(data, ktx2_identifier, 12)) {
+        return false;
+    }
+
+    uint32_t header[9];
+    memcpy(header, data + 12, sizeof(header));
+
+    if (header[8]) {
+        PyErr_Format(PyExc_ValueError, "supercompressed textures are not supported");
+        return false;
+    }
+
+    if (header[4] > 1) {
+        PyErr_Format(PyExc_ValueError, "3d textures are not supported");
+        return false;
+    }
+
+    if (!find_texture_format(&info->format, (VkFormat)header[0], 0)) {
+        PyErr_Format(PyExc_ValueError, "unsupported format %u", header[0]);
+        return false;
+    }
+
+    info->width = header[2];
+    info->height = header[3] ? header[3] : 1;
+    info->levels = header[7] ? header[7] : 1;
+    info->layers = (header[5] ? header[5] : 1) * (header[6] ? header[6] : 1);
+
+    if (80 + (size_t)info->levels * 24 > size) {
+        PyErr_Format(PyExc_ValueError, "invalid texture");
+        return false;
+    }
+
+    info->region_count = info->levels;
+    info->region_array = allocate<TextureRegion>(info->region_count);
+
+    for (uint32_t level = 0; level < info->levels; ++level) {
+        uint64_t level_index[3];
+        memcpy(level_index, data + 80 + level * 24, sizeof(level_index));
+
+        VkDeviceSize level_size = texture_level_size(info->format, info->width, info->height, level) * info->layers;
+
+        if (level_index[1] != level_size || level_index[1] > size || level_index[0] > size - level_index[1]) {
+            PyErr_Format(PyExc_ValueError, "invalid texture");
+            return false;
+        }
+
+        set_texture_region(info, level, level_index[0], level_index[1], level, 0, info->layers);
+    }
+
+    return true;
+}
+
+bool parse_dds(const uint8_t * data, size_t size, TextureInfo * info) {
+    if (size < 128 || memcmp(data, "DDS ", 4)) {
+        return false;
+    }
+
+    uint32_t header[31];
+    memcpy(header, data + 4, sizeof(header));
+
+    uint32_t pixel_format_flags = header[19];
+    uint32_t pixel_format_fourcc = header[20];
+    uint32_t caps2 = header[27];
+
+    info->width = header[3];
+    info->height = header[2];
+    info->levels = header[6] ? header[6] : 1;
+    info->layers = 1;
+
+    if (caps2 & 0x200000) {
+        PyErr_Format(PyExc_ValueError, "3d textures are not supported");
+        return false;
+    }
+
+    if (caps2 & 0x200) {
+        info->layers = 6;
+    }
+
+    size_t offset = 128;
+    bool found = false;
+
+    if ((pixel_format_flags & 0x4) && pixel_format_fourcc == fourcc("DX10")) {
+        if (size < 148) {
+            PyErr_Format(PyExc_ValueError, "invalid texture");
+            return false;
+        }
+
+        uint32_t header_dx10[5];
+        memcpy(header_dx10, data + 128, sizeof(header_dx10));
+        offset = 148;
+
+        if (header_dx10[1] == 4) {
+            PyErr_Format(PyExc_ValueError, "3d textures are not supported");
+            return false;
+        }
+
+        info->layers = (header_dx10[3] ? header_dx10[3] : 1) * (header_dx10[2] & 0x4 ? 6 : 1);
+        found = find_texture_format(&info->format, VK_FORMAT_UNDEFINED, header_dx10[0]);
+    } else if (pixel_format_flags & 0x4) {
+        switch (pixel_format_fourcc) {
+            case fourcc("DXT1"): found = find_texture_format(&info->format, VK_FORMAT_BC1_RGBA_UNORM_BLOCK, 0); break;
+            case fourcc("DXT3"): found = find_texture_format(&info->format, VK_FORMAT_BC2_UNORM_BLOCK, 0); break;
+            case fourcc("DXT5"): found = find_texture_format(&info->format, VK_FORMAT_BC3_UNORM_BLOCK, 0); break;
+            case fourcc("ATI1"): found = find_texture_format(&info->format, VK_FORMAT_BC4_UNORM_BLOCK, 0); break;
+            case fourcc("BC4U"): found = find_texture_format(&info->format, VK_FORMAT_BC4_UNORM_BLOCK, 0); break;
+            case fourcc("ATI2"): found = find_texture_format(&info->format, VK_FORMAT_BC5_UNORM_BLOCK, 0); break;
+            case fourcc("BC5U"): found = find_texture_format(&info->format, VK_FORMAT_BC5_UNORM_BLOCK, 0); break;
+            case 113: found = find_texture_format(&info->format, VK_FORMAT_R16G16B16A16_SFLOAT, 0); break;
+            case 116: found = find_texture_format(&info->format, VK_FORMAT_R32G32B32A32_SFLOAT, 0); break;
+        }
+    } else if ((pixel_format_flags & 0x40) && header[21] == 32) {
+        if (header[22] == 0x000000ff && header[23] == 0x0000ff00 && header[24] == 0x00ff0000) {
+            found = find_texture_format(&info->format, VK_FORMAT_R8G8B8A8_UNORM, 0);
+        }
+        if (header[22] == 0x00ff0000 && header[23] == 0x0000ff00 && header[24] == 0x000000ff) {
+            found = find_texture_format(&info->format, VK_FORMAT_B8G8R8A8_UNORM, 0);
+        }
+    }
+
+    if (!found) {
+        PyErr_Format(PyExc_ValueError, "unsupported format");
+        return false;
+    }
+
+    info->region_count = info->layers * info->levels;
+    info->region_array = allocate<TextureRegion>(info->region_count);
+
+    for (uint32_t layer = 0; layer < info->layers; ++layer) {
+        for (uint32_t level = 0; level < info->levels; ++level) {
+            VkDeviceSize level_size = texture_level_size(info->format, info->width, info->height, level);
+
+            if (offset + level_size > size) {
+                PyErr_Format(PyExc_ValueError, "invalid texture");
+                return false;
+            }
+
+            set_texture_region(info, layer * info->levels + level, offset, level_size, level, layer, 1);
+            offset += level_size;
+        }
+    }
+
+    return true;
+}
+
+Image * Instance_meth_load_texture(Instance * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {"path", "mode", "memory", NULL};
+
+    struct {
+        PyObject * path;
+        PyObject * mode;
+        PyObject * memory = Py_None;
+    } args;
+
+    args.mode = self->state->texture_str;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "O&|$OO",
+        keywords,
+        PyUnicode_FSConverter,
+        &args.path,
+        &args.mode,
+        &args.memory
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (self->group) {
+        Py_DECREF(args.path);
+        PyErr_Format(PyExc_RuntimeError, "cannot load textures within a group");
+        return NULL;
+    }
+
+    MappedFile mapped = {};
+
+    if (!map_file(&mapped, PyBytes_AsString(args.path))) {
+        PyErr_Format(PyExc_OSError, "cannot open %s", PyBytes_AsString(args.path));
+        Py_DECREF(args.path);
+        return NULL;
+    }
+
+    Py_DECREF(args.path);
+
+    TextureInfo info = {};
+    const uint8_t * data = (const uint8_t *)mapped.ptr;
+
+    if (!parse_ktx2(data, mapped.size, &info) && !PyErr_Occurred() && !parse_dds(data, mapped.size, &info) && !PyErr_Occurred()) {
+        PyErr_Format(PyExc_ValueError, "unknown texture container");
+    }
+
+    if (PyErr_Occurred()) {
+        PyMem_Free(info.region_array);
+        unmap_file(&mapped);
+        return NULL;
+    }
+
+    Memory * memory = get_memory(self, args.memory);
+    ImageMode image_mode = get_image_mode(args.mode);
+
+    if (!memory) {
+        PyMem_Free(info.region_array);
+        unmap_file(&mapped);
+        return NULL;
+    }
+
+    if (info.levels > 1 && image_mode == IMG_OUTPUT) {
+        PyMem_Free(info.region_array);
+        unmap_file(&mapped);
+        PyErr_Format(PyExc_ValueError, "invalid mode");
+        return NULL;
+    }
+
+    VkImageUsageFlags image_usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    VkImageLayout image_layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    if (image_mode == IMG_TEXTURE) {
+        image_usage = VK_IMAGE_USAGE_SAMPLED_BIT;
+        image_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    if (image_mode == IMG_STORAGE) {
+        image_usage = VK_IMAGE_USAGE_STORAGE_BIT;
+        image_layout = VK_IMAGE_LAYOUT_GENERAL;
+    }
+
+    Image * res = new_image({
+        self,
+        memory,
+        texture_level_size(info.format, info.width, info.height, 0) * info.layers,
+        image_usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        VK_IMAGE_ASPECT_COLOR_BIT,
+        {info.width, info.height, 1},
+        1,
+        info.levels,
+        info.layers,
+        image_mode,
+        info.format.format,
+        MIP_NONE,
+    });
+
+    allocate_memory(memory);
+    bind_image(res);
+
+    VkDeviceSize alignment = info.format.block_size % 4 ? info.format.block_size * 4 : info.format.block_size;
+    VkDeviceSize staging_size = 0;
+
+    for (uint32_t i = 0; i < info.region_count; ++i) {
+        if (VkDeviceSize padding = staging_size % alignment) {
+            staging_size += alignment - padding;
+        }
+        info.region_array[i].copy.bufferOffset = staging_size;
+        staging_size += info.region_array[i].size;
+    }
+
+    HostBuffer temp = {};
+    new_temp_buffer(self, &temp, staging_size);
+
+    Py_BEGIN_ALLOW_THREADS
+    for (uint32_t i = 0; i < info.region_count; ++i) {
+        memcpy(
+            (char *)temp.ptr + info.region_array[i].copy.bufferOffset,
+            data + info.region_array[i].file_offset,
+            (size_t)info.region_array[i].size
+        );
+    }
+    Py_END_ALLOW_THREADS
+
+    unmap_file(&mapped);
+
+    VkBufferImageCopy * copy_array = allocate<VkBufferImageCopy>(info.region_count);
+    for (uint32_t i = 0; i < info.region_count; ++i) {
+        copy_array[i] = info.region_array[i].copy;
+    }
+
+    begin_commands(self);
+
+    VkImageMemoryBarrier image_barrier_transfer = {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        NULL,
+        0,
+        0,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        res->image,
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, info.levels, 0, info.layers},
+    };
+
+    self->vkCmdPipelineBarrier(
+        self->command_buffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        0,
+        NULL,
+        0,
+        NULL,
+        1,
+        &image_barrier_transfer
+    );
+
+    self->vkCmdCopyBufferToImage(
+        self->command_buffer,
+        temp.buffer,
+        res->image,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        info.region_count,
+        copy_array
+    );
+
+    VkImageMemoryBarrier image_barrier_final = {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        NULL,
+        0,
+        0,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        image_layout,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        res->image,
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, info.levels, 0, info.layers},
+    };
+
+    self->vkCmdPipelineBarrier(
+        self->command_buffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        0,
+        NULL,
+        0,
+        NULL,
+        1,
+        &image_barrier_final
+    );
+
+    end_commands(self);
+    free_temp_buffer(self, &temp);
+
+    PyMem_Free(copy_array);
+    PyMem_Free(info.region_array);
+    return res;
+}
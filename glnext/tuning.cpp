@@ -0,0 +1,386 @@
+#include "glnext.hpp"
+
+uint64_t hash_bytes(uint64_t hash, const void * data, size_t size) {
+    const unsigned char * ptr = (const unsigned char *)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ ptr[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+PyObject * get_tuning_key(Instance * self, PyObject * compute_shader, SpecializationState * specialization, uint32_t * size, uint32_t candidate_count, uint32_t * local_size_array) {
+    // The winner depends on the device and driver, the shader, its constants, the problem size and the candidates offered.
+    VkPhysicalDeviceProperties * properties = &self->physical_device_properties;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    hash = hash_bytes(hash, &properties->vendorID, sizeof(uint32_t));
+    hash = hash_bytes(hash, &properties->deviceID, sizeof(uint32_t));
+    hash = hash_bytes(hash, &properties->driverVersion, sizeof(uint32_t));
+    hash = hash_bytes(hash, PyBytes_AsString(compute_shader), PyBytes_Size(compute_shader));
+    for (uint32_t i = 0; i < specialization->info.mapEntryCount; ++i) {
+        hash = hash_bytes(hash, &specialization->entry_array[i].constantID, sizeof(uint32_t));
+        hash = hash_bytes(hash, &specialization->data[i], sizeof(uint32_t));
+    }
+    hash = hash_bytes(hash, size, sizeof(uint32_t) * 3);
+    hash = hash_bytes(hash, local_size_array, sizeof(uint32_t) * 3 * candidate_count);
+
+    char key[17] = {};
+    snprintf(key, sizeof(key), "%016llx", (unsigned long long)hash);
+    return PyUnicode_FromString(key);
+}
+
+void merge_tuning_file(Instance * self, const char * path) {
+    FILE * file = fopen(path, "r");
+
+    if (!file) {
+        return;
+    }
+
+    char key[17] = {};
+    unsigned x = 0, y = 0, z = 0;
+
+    // Results found by this instance take priority over the ones saved by other processes.
+    while (fscanf(file, "%16s %u %u %u", key, &x, &y, &z) == 4) {
+        if (!PyDict_GetItemString(self->tuning_dict, key)) {
+            PyObject * value = Py_BuildValue("(III)", x, y, z);
+            PyDict_SetItemString(self->tuning_dict, key, value);
+            Py_DECREF(value);
+        }
+    }
+
+    fclose(file);
+}
+
+bool save_tuning_file(Instance * self, const char * path) {
+    if (!PyDict_Size(self->tuning_dict)) {
+        return true;
+    }
+
+    merge_tuning_file(self, path);
+
+    PyObject * data = PyBytes_FromString("");
+    Py_ssize_t pos = 0;
+    PyObject * key = NULL;
+    PyObject * value = NULL;
+
+    while (PyDict_Next(self->tuning_dict, &pos, &key, &value)) {
+        PyObject * line = PyBytes_FromFormat(
+            "%s %lu %lu %lu\n",
+            PyUnicode_AsUTF8(key),
+            PyLong_AsUnsignedLong(PyTuple_GetItem(value, 0)),
+            PyLong_AsUnsignedLong(PyTuple_GetItem(value, 1)),
+            PyLong_AsUnsignedLong(PyTuple_GetItem(value, 2))
+        );
+        PyBytes_ConcatAndDel(&data, line);
+    }
+
+    bool written = write_file(path, PyBytes_AsString(data), PyBytes_Size(data));
+    Py_DECREF(data);
+    return written;
+}
+
+bool valid_local_size(Instance * self, uint32_t * local_size) {
+    VkPhysicalDeviceLimits * limits = &self->physical_device_properties.limits;
+
+    if (!local_size[0] || !local_size[1] || !local_size[2]) {
+        return false;
+    }
+
+    if (local_size[0] > limits->maxComputeWorkGroupSize[0] || local_size[1] > limits->maxComputeWorkGroupSize[1] || local_size[2] > limits->maxComputeWorkGroupSize[2]) {
+        return false;
+    }
+
+    return (uint64_t)local_size[0] * local_size[1] * local_size[2] <= limits->maxComputeWorkGroupInvocations;
+}
+
+ComputePipeline * new_tuned_pipeline(Instance * self, PyObject * kwargs, PyObject * specialization, uint32_t * size, uint32_t * local_size) {
+    PyObject * merged = specialization == Py_None ? PyDict_New() : PyDict_Copy(specialization);
+    PyObject * compute_count = Py_BuildValue(
+        "(III)",
+        (size[0] + local_size[0] - 1) / local_size[0],
+        (size[1] + local_size[1] - 1) / local_size[1],
+        (size[2] + local_size[2] - 1) / local_size[2]
+    );
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        PyObject * constant_id = PyLong_FromUnsignedLong(i);
+        PyObject * value = PyLong_FromUnsignedLong(local_size[i]);
+        PyDict_SetItem(merged, constant_id, value);
+        Py_DECREF(constant_id);
+        Py_DECREF(value);
+    }
+
+    PyDict_SetItemString(kwargs, "specialization", merged);
+    PyDict_SetItemString(kwargs, "compute_count", compute_count);
+    Py_DECREF(compute_count);
+    Py_DECREF(merged);
+
+    PyObject * vargs = PyTuple_New(0);
+    ComputePipeline * res = new_compute_pipeline(self, vargs, kwargs);
+    Py_DECREF(vargs);
+
+    if (!res && !PyErr_Occurred()) {
+        PyErr_Format(PyExc_ValueError, "compute_shader");
+    }
+
+    return res;
+}
+
+// Every candidate really executes on the bindings given, writable buffers see all of the runs.
+void time_pipelines(Instance * self, uint32_t pipeline_count, ComputePipeline ** pipeline_array, uint32_t runs, double * time_array) {
+    for (uint32_t i = 0; i < pipeline_count; ++i) {
+        time_array[i] = -1.0;
+    }
+
+    if (!self->timestamp_valid_bits) {
+        // Without timestamp queries each candidate is timed on the host from submit to fence signal.
+        for (uint32_t run = 0; run < runs; ++run) {
+            for (uint32_t i = 0; i < pipeline_count; ++i) {
+                ComputeState state = {};
+                begin_commands(self);
+                execute_compute_pipeline(pipeline_array[i], self->command_buffer, &state);
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                end_commands(self);
+                std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                if (time_array[i] < 0.0 || elapsed.count() < time_array[i]) {
+                    time_array[i] = elapsed.count();
+                }
+            }
+        }
+        return;
+    }
+
+    VkQueryPoolCreateInfo query_pool_create_info = {
+        VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        NULL,
+        0,
+        VK_QUERY_TYPE_TIMESTAMP,
+        pipeline_count * 2,
+        0,
+    };
+
+    VkQueryPool query_pool = NULL;
+    self->vkCreateQueryPool(self->device, &query_pool_create_info, NULL, &query_pool);
+
+    uint64_t * timestamp_array = allocate<uint64_t>(pipeline_count * 2);
+    uint64_t mask = self->timestamp_valid_bits < 64 ? (1ull << self->timestamp_valid_bits) - 1 : ~0ull;
+    double period = self->physical_device_properties.limits.timestampPeriod;
+
+    for (uint32_t run = 0; run < runs; ++run) {
+        begin_commands(self);
+        self->vkCmdResetQueryPool(self->command_buffer, query_pool, 0, pipeline_count * 2);
+
+        for (uint32_t i = 0; i < pipeline_count; ++i) {
+            // Candidates must not overlap, the previous one has to finish before the start timestamp.
+            ComputeState state = {VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT};
+            flush_compute_state(self, self->command_buffer, &state);
+            self->vkCmdWriteTimestamp(self->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query_pool, i * 2);
+            execute_compute_pipeline(pipeline_array[i], self->command_buffer, &state);
+            self->vkCmdWriteTimestamp(self->command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool, i * 2 + 1);
+        }
+
+        end_commands(self);
+
+        self->vkGetQueryPoolResults(
+            self->device,
+            query_pool,
+            0,
+            pipeline_count * 2,
+            sizeof(uint64_t) * pipeline_count * 2,
+            timestamp_array,
+            sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT
+        );
+
+        for (uint32_t i = 0; i < pipeline_count; ++i) {
+            double elapsed = (double)((timestamp_array[i * 2 + 1] - timestamp_array[i * 2]) & mask) * period;
+            if (time_array[i] < 0.0 || elapsed < time_array[i]) {
+                time_array[i] = elapsed;
+            }
+        }
+    }
+
+    PyMem_Free(timestamp_array);
+    self->vkDestroyQueryPool(self->device, query_pool, NULL);
+}
+
+ComputePipeline * Task_meth_autotune(Task * self, PyObject * vargs, PyObject * kwargs) {
+    static char * keywords[] = {
+        "compute_shader",
+        "size",
+        "candidates",
+        "bindings",
+        "specialization",
+        "push_constants",
+        "runs",
+        "memory",
+        NULL,
+    };
+
+    struct {
+        PyObject * compute_shader = NULL;
+        PyObject * size = NULL;
+        PyObject * candidates = NULL;
+        PyObject * bindings;
+        PyObject * specialization = Py_None;
+        uint32_t push_constants = 0;
+        uint32_t runs = 5;
+        PyObject * memory = Py_None;
+    } args;
+
+    Instance * instance = self->instance;
+    args.bindings = instance->state->empty_list;
+
+    int args_ok = PyArg_ParseTupleAndKeywords(
+        vargs,
+        kwargs,
+        "|$O!OO!OOIIO",
+        keywords,
+        &PyBytes_Type,
+        &args.compute_shader,
+        &args.size,
+        &PyList_Type,
+        &args.candidates,
+        &args.bindings,
+        &args.specialization,
+        &args.push_constants,
+        &args.runs,
+        &args.memory
+    );
+
+    if (!args_ok) {
+        return NULL;
+    }
+
+    if (!args.compute_shader || !args.size || !args.candidates) {
+        PyErr_Format(PyExc_TypeError, "missing compute_shader, size or candidates");
+        return NULL;
+    }
+
+    SpecializationState specialization;
+
+    if (!parse_specialization(&specialization, args.specialization)) {
+        return NULL;
+    }
+
+    if (instance->group) {
+        PyErr_Format(PyExc_RuntimeError, "cannot autotune within a group");
+        return NULL;
+    }
+
+    uint32_t size[3] = {};
+
+    if (!parse_compute_count(args.size, size) || !size[0] || !size[1] || !size[2]) {
+        PyErr_Clear();
+        PyErr_Format(PyExc_ValueError, "size");
+        return NULL;
+    }
+
+    if (!args.runs) {
+        PyErr_Format(PyExc_ValueError, "runs");
+        return NULL;
+    }
+
+    // Candidates the device cannot run are dropped instead of failing the whole search.
+    uint32_t candidate_count = 0;
+    uint32_t * local_size_array = allocate<uint32_t>((uint32_t)PyList_Size(args.candidates) * 3 + 3);
+
+    for (uint32_t i = 0; i < (uint32_t)PyList_Size(args.candidates); ++i) {
+        uint32_t * local_size = local_size_array + candidate_count * 3;
+        if (!parse_compute_count(PyList_GetItem(args.candidates, i), local_size)) {
+            PyErr_Clear();
+            PyMem_Free(local_size_array);
+            PyErr_Format(PyExc_ValueError, "candidates");
+            return NULL;
+        }
+        if (valid_local_size(instance, local_size)) {
+            candidate_count += 1;
+        }
+    }
+
+    if (!candidate_count) {
+        PyMem_Free(local_size_array);
+        PyErr_Format(PyExc_ValueError, "candidates");
+        return NULL;
+    }
+
+    PyObject * pipeline_kwargs = Py_BuildValue(
+        "{sOsOsIsO}",
+        "compute_shader", args.compute_shader,
+        "bindings", args.bindings,
+        "push_constants", args.push_constants,
+        "memory", args.memory
+    );
+
+    PyObject * key = get_tuning_key(instance, args.compute_shader, &specialization, size, candidate_count, local_size_array);
+    PyObject * tuned = PyDict_GetItem(instance->tuning_dict, key);
+    uint32_t local_size[3] = {};
+
+    // Winners loaded from a tuning file are trusted only if they still fit the device, otherwise the search runs again.
+    if (tuned && (!parse_compute_count(tuned, local_size) || !valid_local_size(instance, local_size))) {
+        PyErr_Clear();
+        PyDict_DelItem(instance->tuning_dict, key);
+        tuned = NULL;
+    }
+
+    if (tuned) {
+        ComputePipeline * res = new_tuned_pipeline(instance, pipeline_kwargs, args.specialization, size, local_size);
+        Py_DECREF(pipeline_kwargs);
+        Py_DECREF(key);
+        PyMem_Free(local_size_array);
+        if (!res) {
+            return NULL;
+        }
+        PyList_Append(self->task_list, (PyObject *)res);
+        return res;
+    }
+
+    ComputePipeline ** pipeline_array = allocate<ComputePipeline *>(candidate_count);
+
+    for (uint32_t i = 0; i < candidate_count; ++i) {
+        pipeline_array[i] = new_tuned_pipeline(instance, pipeline_kwargs, args.specialization, size, local_size_array + i * 3);
+        if (!pipeline_array[i]) {
+            for (uint32_t j = 0; j < i; ++j) {
+                Py_DECREF(pipeline_array[j]);
+            }
+            PyMem_Free(pipeline_array);
+            Py_DECREF(pipeline_kwargs);
+            Py_DECREF(key);
+            PyMem_Free(local_size_array);
+            return NULL;
+        }
+    }
+
+    Py_DECREF(pipeline_kwargs);
+    compile_pipelines(instance);
+
+    double * time_array = allocate<double>(candidate_count);
+    time_pipelines(instance, candidate_count, pipeline_array, args.runs, time_array);
+
+    uint32_t winner = 0;
+    for (uint32_t i = 1; i < candidate_count; ++i) {
+        if (time_array[i] < time_array[winner]) {
+            winner = i;
+        }
+    }
+
+    uint32_t * winner_local_size = local_size_array + winner * 3;
+    PyObject * value = Py_BuildValue("(III)", winner_local_size[0], winner_local_size[1], winner_local_size[2]);
+    PyDict_SetItem(instance->tuning_dict, key, value);
+    Py_DECREF(value);
+    Py_DECREF(key);
+
+    ComputePipeline * res = pipeline_array[winner];
+
+    for (uint32_t i = 0; i < candidate_count; ++i) {
+        if (i != winner) {
+            Py_DECREF(pipeline_array[i]);
+        }
+    }
+
+    PyMem_Free(time_array);
+    PyMem_Free(pipeline_array);
+    PyMem_Free(local_size_array);
+
+    PyList_Append(self->task_list, (PyObject *)res);
+    return res;
+}
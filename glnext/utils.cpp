@@ -100,6 +100,42 @@ void free_memory(Memory * self) {
     self->size = 0;
 }
 
+VkFormat get_mipmap_format(ImageCreateInfo * info) {
+    // The single pass keeps one texel per 64x64 tile of a layer in the intermediate buffer, at most 64x64 of them.
+    if (info->levels < 2 || info->levels > 13 || info->extent.width > 4096 || info->extent.height > 4096) {
+        return VK_FORMAT_UNDEFINED;
+    }
+
+    if (info->filter == MIP_NONE || info->samples != 1 || info->aspect != VK_IMAGE_ASPECT_COLOR_BIT || is_integer_format(info->format)) {
+        return VK_FORMAT_UNDEFINED;
+    }
+
+    if (!info->instance->physical_device_features.shaderStorageImageWriteWithoutFormat) {
+        return VK_FORMAT_UNDEFINED;
+    }
+
+    // The sRGB formats rarely support storage, a UNORM alias would need extended usage on every view of the image.
+    switch (info->format) {
+        case VK_FORMAT_R8_SRGB:
+        case VK_FORMAT_R8G8_SRGB:
+        case VK_FORMAT_R8G8B8_SRGB:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            return VK_FORMAT_UNDEFINED;
+        default:
+            break;
+    }
+
+    VkFormatProperties format_properties = {};
+    info->instance->vkGetPhysicalDeviceFormatProperties(info->instance->physical_device, info->format, &format_properties);
+
+    VkFormatFeatureFlags required_features = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+    if ((format_properties.optimalTilingFeatures & required_features) != required_features) {
+        return VK_FORMAT_UNDEFINED;
+    }
+
+    return info->format;
+}
+
 Image * new_image(ImageCreateInfo info) {
     Image * res = PyObject_New(Image, info.instance->state->Image_type);
 
@@ -116,12 +152,26 @@ Image * new_image(ImageCreateInfo info) {
     res->format = info.format;
     res->image = NULL;
     res->bound = false;
+    res->read_image_view = NULL;
+    res->read_descriptor_pool = NULL;
+    res->read_descriptor_set = NULL;
+    res->read_buffer = NULL;
+    res->filter = info.filter;
+    res->mipmap_format = get_mipmap_format(&info);
+    memset(res->mipmap_image_view_array, 0, sizeof(res->mipmap_image_view_array));
+    res->mipmap_descriptor_pool = NULL;
+    res->mipmap_descriptor_set = NULL;
+    res->mipmap_buffer = NULL;
 
     VkImageCreateFlags flags = 0;
     if (info.mode == IMG_STORAGE) {
         flags = VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
     }
 
+    if (res->mipmap_format) {
+        info.usage |= VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    }
+
     if (info.layers % 6 == 0) {
         flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
     }
@@ -219,7 +269,7 @@ void new_temp_buffer(Instance * self, HostBuffer * temp, VkDeviceSize size) {
         NULL,
         0,
         size,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
         VK_SHARING_MODE_EXCLUSIVE,
         0,
         NULL,
@@ -248,7 +298,455 @@ void free_temp_buffer(Instance * self, HostBuffer * temp) {
     self->vkDestroyBuffer(self->device, temp->buffer, NULL);
 }
 
+VkShaderModule get_shader_module(Instance * self, PyObject * code) {
+    PyObject * cached = PyDict_GetItem(self->shader_module_dict, code);
+    if (cached) {
+        return (VkShaderModule)PyLong_AsVoidPtr(cached);
+    }
+
+    VkShaderModuleCreateInfo shader_module_create_info = {
+        VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        NULL,
+        0,
+        (VkDeviceSize)PyBytes_Size(code),
+        (uint32_t *)PyBytes_AsString(code),
+    };
+
+    VkShaderModule shader_module = NULL;
+    self->vkCreateShaderModule(self->device, &shader_module_create_info, NULL, &shader_module);
+
+    PyObject * ptr = PyLong_FromVoidPtr(shader_module);
+    PyDict_SetItem(self->shader_module_dict, code, ptr);
+    Py_DECREF(ptr);
+    return shader_module;
+}
+
+PipelineLayout * get_pipeline_layout(Instance * self, uint32_t binding_count, VkDescriptorSetLayoutBinding * binding_array, VkPushConstantRange * push_constant_range) {
+    uint32_t key_size = binding_count * 4 + 3;
+    uint32_t * key_data = allocate<uint32_t>(key_size);
+
+    for (uint32_t i = 0; i < binding_count; ++i) {
+        key_data[i * 4 + 0] = binding_array[i].binding;
+        key_data[i * 4 + 1] = binding_array[i].descriptorType;
+        key_data[i * 4 + 2] = binding_array[i].descriptorCount;
+        key_data[i * 4 + 3] = binding_array[i].stageFlags;
+    }
+
+    key_data[binding_count * 4 + 0] = push_constant_range ? push_constant_range->stageFlags : 0;
+    key_data[binding_count * 4 + 1] = push_constant_range ? push_constant_range->offset : 0;
+    key_data[binding_count * 4 + 2] = push_constant_range ? push_constant_range->size : 0;
+
+    PyObject * key = PyBytes_FromStringAndSize((char *)key_data, key_size * sizeof(uint32_t));
+    PyMem_Free(key_data);
+
+    PyObject * cached = PyDict_GetItem(self->pipeline_layout_dict, key);
+    if (cached) {
+        Py_DECREF(key);
+        return (PipelineLayout *)PyLong_AsVoidPtr(cached);
+    }
+
+    PipelineLayout * res = allocate<PipelineLayout>(1);
+    res->descriptor_set_layout = NULL;
+
+    VkPipelineLayoutCreateInfo pipeline_layout_create_info = {
+        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        NULL,
+        0,
+        0,
+        NULL,
+        push_constant_range ? 1u : 0u,
+        push_constant_range,
+    };
+
+    if (binding_count) {
+        VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info = {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            NULL,
+            0,
+            binding_count,
+            binding_array,
+        };
+
+        self->vkCreateDescriptorSetLayout(self->device, &descriptor_set_layout_create_info, NULL, &res->descriptor_set_layout);
+
+        pipeline_layout_create_info.setLayoutCount = 1;
+        pipeline_layout_create_info.pSetLayouts = &res->descriptor_set_layout;
+    }
+
+    self->vkCreatePipelineLayout(self->device, &pipeline_layout_create_info, NULL, &res->pipeline_layout);
+
+    PyObject * ptr = PyLong_FromVoidPtr(res);
+    PyDict_SetItem(self->pipeline_layout_dict, key, ptr);
+    Py_DECREF(ptr);
+    Py_DECREF(key);
+    return res;
+}
+
+bool map_file(MappedFile * mapped, const char * path) {
+    *mapped = {};
+
+    #ifdef BUILD_WINDOWS
+    mapped->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (mapped->file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size = {};
+    GetFileSizeEx(mapped->file, &file_size);
+    mapped->size = (size_t)file_size.QuadPart;
+    if (mapped->size) {
+        mapped->mapping = CreateFileMappingA(mapped->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        mapped->ptr = mapped->mapping ? MapViewOfFile(mapped->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+        if (!mapped->ptr) {
+            unmap_file(mapped);
+            return false;
+        }
+    }
+    #else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_stat = {};
+    fstat(fd, &file_stat);
+    mapped->size = (size_t)file_stat.st_size;
+    if (mapped->size) {
+        mapped->ptr = mmap(NULL, mapped->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped->ptr == MAP_FAILED) {
+            mapped->ptr = NULL;
+            close(fd);
+            return false;
+        }
+    }
+    close(fd);
+    #endif
+
+    return true;
+}
+
+void unmap_file(MappedFile * mapped) {
+    #ifdef BUILD_WINDOWS
+    if (mapped->ptr) {
+        UnmapViewOfFile(mapped->ptr);
+    }
+    if (mapped->mapping) {
+        CloseHandle(mapped->mapping);
+    }
+    if (mapped->file && mapped->file != INVALID_HANDLE_VALUE) {
+        CloseHandle(mapped->file);
+    }
+    #else
+    if (mapped->ptr) {
+        munmap(mapped->ptr, mapped->size);
+    }
+    #endif
+
+    *mapped = {};
+}
+
+bool write_file(const char * path, const void * data, size_t size) {
+    #ifdef BUILD_WINDOWS
+    unsigned long pid = GetCurrentProcessId();
+    #else
+    unsigned long pid = (unsigned long)getpid();
+    #endif
+
+    // Write next to the target and rename, readers never observe a partially written file.
+    PyObject * temp_path = PyBytes_FromFormat("%s.%lu.tmp", path, pid);
+    const char * temp = PyBytes_AsString(temp_path);
+
+    FILE * file = fopen(temp, "wb");
+    bool written = file && fwrite(data, 1, size, file) == size;
+    written = file && !fclose(file) && written;
+
+    #ifdef BUILD_WINDOWS
+    written = written && MoveFileExA(temp, path, MOVEFILE_REPLACE_EXISTING);
+    #else
+    written = written && !rename(temp, path);
+    #endif
+
+    if (!written) {
+        remove(temp);
+    }
+
+    Py_DECREF(temp_path);
+    return written;
+}
+
+void create_mipmap_descriptor_set(Image * self, Kernel * kernel, VkDeviceSize counter_size, VkDeviceSize intermediate_size) {
+    Instance * instance = self->instance;
+
+    VkImageViewCreateInfo image_view_create_info = {
+        VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        NULL,
+        0,
+        self->image,
+        VK_IMAGE_VIEW_TYPE_2D_ARRAY,
+        self->format,
+        {VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY},
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, self->levels, 0, self->layers},
+    };
+
+    instance->vkCreateImageView(instance->device, &image_view_create_info, NULL, &self->mipmap_image_view_array[0]);
+
+    // Every level binding must be valid, the ones past the last level repeat it and are never written.
+    image_view_create_info.format = self->mipmap_format;
+    for (uint32_t i = 1; i < 13; ++i) {
+        uint32_t level = i < self->levels ? i : self->levels - 1;
+        image_view_create_info.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, self->layers};
+        instance->vkCreateImageView(instance->device, &image_view_create_info, NULL, &self->mipmap_image_view_array[i]);
+    }
+
+    self->mipmap_buffer = new_primitive_buffer(instance, counter_size + intermediate_size);
+
+    VkDescriptorPoolSize descriptor_pool_size_array[] = {
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 12},
+    };
+
+    VkDescriptorPoolCreateInfo descriptor_pool_create_info = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        NULL,
+        0,
+        1,
+        3,
+        descriptor_pool_size_array,
+    };
+
+    instance->vkCreateDescriptorPool(instance->device, &descriptor_pool_create_info, NULL, &self->mipmap_descriptor_pool);
+
+    VkDescriptorSetAllocateInfo descriptor_set_allocate_info = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        NULL,
+        self->mipmap_descriptor_pool,
+        1,
+        &kernel->descriptor_set_layout,
+    };
+
+    instance->vkAllocateDescriptorSets(instance->device, &descriptor_set_allocate_info, &self->mipmap_descriptor_set);
+
+    VkDescriptorImageInfo descriptor_image_info_array[13];
+    descriptor_image_info_array[0] = {get_kernel_sampler(instance), self->mipmap_image_view_array[0], VK_IMAGE_LAYOUT_GENERAL};
+    for (uint32_t i = 1; i < 13; ++i) {
+        descriptor_image_info_array[i] = {NULL, self->mipmap_image_view_array[i], VK_IMAGE_LAYOUT_GENERAL};
+    }
+
+    VkDescriptorBufferInfo descriptor_buffer_info_array[] = {
+        {self->mipmap_buffer->buffer, 0, counter_size},
+        {self->mipmap_buffer->buffer, counter_size, intermediate_size},
+    };
+
+    VkWriteDescriptorSet write_descriptor_set_array[] = {
+        {
+            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            NULL,
+            self->mipmap_descriptor_set,
+            0,
+            0,
+            1,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            descriptor_image_info_array,
+            NULL,
+            NULL,
+        },
+        {
+            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            NULL,
+            self->mipmap_descriptor_set,
+            1,
+            0,
+            2,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            NULL,
+            descriptor_buffer_info_array,
+            NULL,
+        },
+        {
+            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            NULL,
+            self->mipmap_descriptor_set,
+            3,
+            0,
+            12,
+            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            descriptor_image_info_array + 1,
+            NULL,
+            NULL,
+        },
+    };
+
+    instance->vkUpdateDescriptorSets(instance->device, 3, write_descriptor_set_array, 0, NULL);
+}
+
+void record_mipmap_kernel(Image * self, Kernel * kernel, VkCommandBuffer command_buffer) {
+    Instance * instance = self->instance;
+
+    uint32_t groups_x = (self->extent.width + 63) / 64;
+    uint32_t groups_y = (self->extent.height + 63) / 64;
+
+    VkDeviceSize alignment = instance->physical_device_properties.limits.minStorageBufferOffsetAlignment;
+    VkDeviceSize counter_size = (self->layers * 4 + alignment - 1) / alignment * alignment;
+    VkDeviceSize intermediate_size = (VkDeviceSize)groups_x * groups_y * self->layers * 16;
+
+    if (!self->mipmap_descriptor_set) {
+        create_mipmap_descriptor_set(self, kernel, counter_size, intermediate_size);
+    }
+
+    instance->vkCmdFillBuffer(command_buffer, self->mipmap_buffer->buffer, 0, counter_size, 0);
+
+    VkMemoryBarrier memory_barrier = {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+    };
+
+    VkImageMemoryBarrier image_barrier_array[] = {
+        {
+            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            NULL,
+            VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_IMAGE_LAYOUT_GENERAL,
+            VK_QUEUE_FAMILY_IGNORED,
+            VK_QUEUE_FAMILY_IGNORED,
+            self->image,
+            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, self->layers},
+        },
+        {
+            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            NULL,
+            0,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_GENERAL,
+            VK_QUEUE_FAMILY_IGNORED,
+            VK_QUEUE_FAMILY_IGNORED,
+            self->image,
+            {VK_IMAGE_ASPECT_COLOR_BIT, 1, self->levels - 1, 0, self->layers},
+        },
+    };
+
+    instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        1,
+        &memory_barrier,
+        0,
+        NULL,
+        2,
+        image_barrier_array
+    );
+
+    instance->vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, kernel->pipeline);
+
+    instance->vkCmdBindDescriptorSets(
+        command_buffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        kernel->pipeline_layout,
+        0,
+        1,
+        &self->mipmap_descriptor_set,
+        0,
+        NULL
+    );
+
+    uint32_t parameters[7] = {
+        self->extent.width,
+        self->extent.height,
+        self->levels,
+        (uint32_t)self->filter,
+        0,
+        groups_x,
+        groups_y,
+    };
+
+    if (self->filter != MIP_KAISER) {
+        // All levels of every layer in a single dispatch, the last workgroup of a layer finishes the small levels.
+        instance->vkCmdPushConstants(command_buffer, kernel->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, 28, parameters);
+        instance->vkCmdDispatch(command_buffer, groups_x, groups_y, self->layers);
+    } else {
+        // The wider footprint reads across workgroup tiles, every level is a dispatch reading the previous one.
+        memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, NULL, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT};
+
+        for (uint32_t level = 1; level < self->levels; ++level) {
+            if (level > 1) {
+                instance->vkCmdPipelineBarrier(
+                    command_buffer,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    0,
+                    1,
+                    &memory_barrier,
+                    0,
+                    NULL,
+                    0,
+                    NULL
+                );
+            }
+
+            uint32_t width = self->extent.width >> level ? self->extent.width >> level : 1;
+            uint32_t height = self->extent.height >> level ? self->extent.height >> level : 1;
+            parameters[4] = level;
+            instance->vkCmdPushConstants(command_buffer, kernel->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, 28, parameters);
+            instance->vkCmdDispatch(command_buffer, (width + 15) / 16, (height + 15) / 16, self->layers);
+        }
+    }
+
+    VkImageMemoryBarrier image_barrier = {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT,
+        VK_IMAGE_LAYOUT_GENERAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        self->image,
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, self->levels, 0, self->layers},
+    };
+
+    instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        0,
+        NULL,
+        0,
+        NULL,
+        1,
+        &image_barrier
+    );
+}
+
 void build_mipmaps(BuildMipmapsInfo args) {
+    // Images the kernel can write get every level from a compute dispatch, the rest fall back to a blit per level.
+    Kernel * kernel = NULL;
+    uint32_t image_count = 0;
+    Image * image_array[64];
+
+    for (uint32_t i = 0; i < args.image_count; ++i) {
+        if (args.image_array[i]->mipmap_format && !kernel) {
+            kernel = get_mipmap_kernel(args.instance);
+        }
+        if (args.image_array[i]->mipmap_format && kernel) {
+            record_mipmap_kernel(args.image_array[i], kernel, args.command_buffer);
+        } else {
+            image_array[image_count++] = args.image_array[i];
+        }
+    }
+
+    args.image_count = image_count;
+    args.image_array = image_array;
+
+    if (!args.image_count) {
+        return;
+    }
+
     for (uint32_t level = 1; level < args.levels; ++level) {
         uint32_t parent = level - 1;
         VkImageBlit image_blit = {
@@ -337,6 +835,75 @@ void build_mipmaps(BuildMipmapsInfo args) {
     }
 }
 
+int parse_specialization(SpecializationState * specialization, PyObject * obj) {
+    memset(specialization, 0, sizeof(SpecializationState));
+
+    if (obj == Py_None) {
+        return 1;
+    }
+
+    if (!PyDict_Check(obj) || PyDict_Size(obj) > 64) {
+        PyErr_Format(PyExc_ValueError, "specialization");
+        return 0;
+    }
+
+    uint32_t count = 0;
+    Py_ssize_t pos = 0;
+    PyObject * key = NULL;
+    PyObject * value = NULL;
+
+    while (PyDict_Next(obj, &pos, &key, &value)) {
+        uint32_t constant_id = PyLong_AsUnsignedLong(key);
+        uint32_t data = 0;
+
+        if (PyBool_Check(value)) {
+            data = value == Py_True;
+        } else if (PyFloat_Check(value)) {
+            float temp = (float)PyFloat_AsDouble(value);
+            memcpy(&data, &temp, 4);
+        } else if (PyLong_Check(value)) {
+            long long temp = PyLong_AsLongLong(value);
+            if (temp < INT32_MIN || temp > UINT32_MAX) {
+                PyErr_Format(PyExc_ValueError, "specialization");
+                return 0;
+            }
+            data = (uint32_t)temp;
+        } else {
+            PyErr_Format(PyExc_ValueError, "specialization");
+            return 0;
+        }
+
+        if (PyErr_Occurred()) {
+            PyErr_Format(PyExc_ValueError, "specialization");
+            return 0;
+        }
+
+        // Entries are kept sorted so the same constants always produce the same pipeline key.
+        uint32_t index = count++;
+        while (index && specialization->entry_array[index - 1].constantID > constant_id) {
+            specialization->entry_array[index] = specialization->entry_array[index - 1];
+            specialization->data[index] = specialization->data[index - 1];
+            index -= 1;
+        }
+
+        specialization->entry_array[index] = {constant_id, 0, 4};
+        specialization->data[index] = data;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        specialization->entry_array[i].offset = i * 4;
+    }
+
+    specialization->info = {
+        count,
+        specialization->entry_array,
+        count * 4,
+        specialization->data,
+    };
+
+    return 1;
+}
+
 VkPrimitiveTopology get_topology(PyObject * name) {
     if (!PyUnicode_CompareWithASCIIString(name, "points")) {
         return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
@@ -360,6 +927,22 @@ VkPrimitiveTopology get_topology(PyObject * name) {
     return VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
 }
 
+MipmapFilter get_mipmap_filter(PyObject * name) {
+    if (!PyUnicode_CompareWithASCIIString(name, "box")) {
+        return MIP_BOX;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "kaiser")) {
+        return MIP_KAISER;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "min")) {
+        return MIP_MIN;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "max")) {
+        return MIP_MAX;
+    }
+    return MIP_INVALID;
+}
+
 ImageMode get_image_mode(PyObject * name) {
     if (!PyUnicode_CompareWithASCIIString(name, "texture")) {
         return IMG_TEXTURE;
@@ -373,6 +956,29 @@ ImageMode get_image_mode(PyObject * name) {
     return IMG_PROTECTED;
 }
 
+VkAttachmentLoadOp get_load_op(PyObject * name) {
+    if (!PyUnicode_CompareWithASCIIString(name, "clear")) {
+        return VK_ATTACHMENT_LOAD_OP_CLEAR;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "load")) {
+        return VK_ATTACHMENT_LOAD_OP_LOAD;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "dont_care")) {
+        return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    }
+    return VK_ATTACHMENT_LOAD_OP_MAX_ENUM;
+}
+
+VkAttachmentStoreOp get_store_op(PyObject * name) {
+    if (!PyUnicode_CompareWithASCIIString(name, "store")) {
+        return VK_ATTACHMENT_STORE_OP_STORE;
+    }
+    if (!PyUnicode_CompareWithASCIIString(name, "dont_care")) {
+        return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    }
+    return VK_ATTACHMENT_STORE_OP_MAX_ENUM;
+}
+
 uint16_t half_float(double value) {
     union {
         float f;
@@ -535,3 +1141,55 @@ Format get_format(PyObject * name) {
     PyErr_Format(PyExc_ValueError, "format");
     return {};
 }
+
+bool check_condition_buffer(Instance * instance, Buffer * buffer, VkDeviceSize offset) {
+    if (!buffer) {
+        return true;
+    }
+
+    if (!instance->extension.conditional_rendering || !(buffer->usage & VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT)) {
+        PyErr_Format(PyExc_ValueError, "condition_buffer");
+        return false;
+    }
+
+    if (offset % 4 || offset + 4 > buffer->size) {
+        PyErr_Format(PyExc_ValueError, "condition_buffer");
+        return false;
+    }
+
+    return true;
+}
+
+void condition_barrier(Instance * instance, VkCommandBuffer command_buffer) {
+    VkMemoryBarrier memory_barrier = {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        NULL,
+        VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+    };
+
+    instance->vkCmdPipelineBarrier(
+        command_buffer,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT,
+        0,
+        1,
+        &memory_barrier,
+        0,
+        NULL,
+        0,
+        NULL
+    );
+}
+
+void begin_conditional_rendering(Instance * instance, VkCommandBuffer command_buffer, Buffer * buffer, VkDeviceSize offset) {
+    VkConditionalRenderingBeginInfoEXT conditional_rendering_begin_info = {
+        VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT,
+        NULL,
+        buffer->buffer,
+        offset,
+        0,
+    };
+
+    instance->vkCmdBeginConditionalRenderingEXT(command_buffer, &conditional_rendering_begin_info);
+}
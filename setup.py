@@ -1,9 +1,95 @@
 import os
 import platform
+import shutil
+import struct
+import subprocess
+import sys
 from setuptools import Extension, setup
 
 PLATFORMS = {'windows', 'linux', 'darwin'}
 
+KERNEL_HEADER = 'glnext/spirv.hpp'
+
+KERNELS = [
+    ('read_kernel', ['read.comp']),
+    ('cull_kernel', ['cull.comp']),
+    ('mipmap_kernel', ['mipmap.comp']),
+]
+
+for primitive in ['reduce', 'partial', 'scan', 'compact', 'histogram', 'scatter']:
+    KERNELS.append(('%s_primitive' % primitive, ['primitive_header.glsl', 'primitive_common.glsl', 'primitive_%s.glsl' % primitive]))
+    KERNELS.append(('%s_primitive_subgroup' % primitive, ['primitive_subgroup_header.glsl', 'primitive_common.glsl', 'primitive_%s.glsl' % primitive]))
+
+
+def find_kernel_compiler():
+    try:
+        from glnext_compiler import glsl
+        return glsl
+    except ImportError:
+        pass
+
+    if shutil.which('glslc'):
+        def glslc(source):
+            command = ['glslc', '-fshader-stage=compute', '--target-env=vulkan1.1', '-o', '-', '-']
+            return subprocess.run(command, input=source.encode(), stdout=subprocess.PIPE, check=True).stdout
+        return glslc
+
+
+def build_kernels():
+    compiler = find_kernel_compiler()
+
+    # Source distributions ship the generated header, it is only rebuilt when a compiler is present or a kernel is missing.
+    if compiler is None and os.path.isfile(KERNEL_HEADER):
+        with open(KERNEL_HEADER) as f:
+            content = f.read()
+        if all('const KernelCode %s_code = ' % name in content for name, parts in KERNELS):
+            return
+
+    if compiler is None:
+        print('glnext: no shader compiler found, the built-in kernels are not available', file=sys.stderr)
+
+    lines = ['// Generated by setup.py from glnext/kernels, do not edit.', '']
+
+    for name, parts in KERNELS:
+        spv = None
+
+        if compiler is not None:
+            source = ''
+            for part in parts:
+                with open(os.path.join('glnext/kernels', part)) as f:
+                    source += f.read()
+
+            # Compilers without subgroup arithmetic leave the subgroup variants empty, the shared memory ones are used instead.
+            try:
+                spv = compiler(source)
+            except Exception:
+                if not name.endswith('_subgroup'):
+                    raise
+
+        if spv is None:
+            lines.append('const KernelCode %s_code = {NULL, 0};' % name)
+            lines.append('')
+            continue
+
+        words = struct.unpack('<%dI' % (len(spv) // 4), spv)
+        lines.append('const uint32_t %s_words[] = {' % name)
+        for i in range(0, len(words), 8):
+            lines.append('    ' + ', '.join('0x%08x' % word for word in words[i:i + 8]) + ',')
+        lines.append('};')
+        lines.append('')
+        lines.append('const KernelCode %s_code = {%s_words, sizeof(%s_words)};' % (name, name, name))
+        lines.append('')
+
+    content = '\n'.join(lines)
+    if os.path.isfile(KERNEL_HEADER):
+        with open(KERNEL_HEADER) as f:
+            if f.read() == content:
+                return
+
+    with open(KERNEL_HEADER, 'w') as f:
+        f.write(content)
+
+
 target = platform.system().lower()
 
 for known in PLATFORMS:
@@ -27,8 +113,12 @@ libraries = []
 
 if target == 'linux':
     extra_compile_args.append('-fpermissive')
+    extra_compile_args.append('-pthread')
+    extra_link_args.append('-pthread')
     libraries.append('dl')
 
+build_kernels()
+
 glnext = Extension(
     name='glnext',
     sources=['glnext/glnext.cpp'],
@@ -44,11 +134,16 @@ glnext = Extension(
         'glnext/image.cpp',
         'glnext/info.cpp',
         'glnext/instance.cpp',
+        'glnext/kernels.cpp',
         'glnext/loader.cpp',
+        'glnext/primitives.cpp',
         'glnext/render_pipeline.cpp',
+        'glnext/spirv.hpp',
         'glnext/surface.cpp',
         'glnext/task.cpp',
+        'glnext/texture.cpp',
         'glnext/tools.cpp',
+        'glnext/tuning.cpp',
         'glnext/utils.cpp',
     ],
     define_macros=define_macros,
@@ -0,0 +1,27 @@
+from glnext_compiler import glsl
+
+FULLSCREEN_VERTEX_SHADER = glsl('''
+    #version 450
+    #pragma shader_stage(vertex)
+
+    vec2 positions[3] = vec2[](
+        vec2(-1.0, -1.0),
+        vec2(3.0, -1.0),
+        vec2(-1.0, 3.0)
+    );
+
+    void main() {
+        gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+    }
+''')
+
+RED_FRAGMENT_SHADER = glsl('''
+    #version 450
+    #pragma shader_stage(fragment)
+
+    layout (location = 0) out vec4 out_color;
+
+    void main() {
+        out_color = vec4(1.0, 0.0, 0.0, 1.0);
+    }
+''')
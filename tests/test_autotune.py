@@ -0,0 +1,42 @@
+import struct
+
+import pytest
+from glnext_compiler import glsl
+
+
+def test_autotune(instance):
+    task = instance.task()
+
+    compute_shader = glsl('''
+        #version 450
+        #pragma shader_stage(compute)
+
+        layout (local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+        layout (binding = 0) buffer Output {
+            uint output_value[];
+        };
+
+        void main() {
+            if (gl_GlobalInvocationID.x < 1000) {
+                output_value[gl_GlobalInvocationID.x] = gl_GlobalInvocationID.x;
+            }
+        }
+    ''')
+
+    output = instance.buffer('storage_buffer', 4000, readable=True)
+
+    pipeline = task.autotune(
+        compute_shader=compute_shader,
+        size=1000,
+        candidates=[32, 64, 128, 256, 1 << 20],
+        bindings=[{'binding': 0, 'type': 'storage_buffer', 'buffer': output}],
+    )
+
+    assert pipeline is not None
+    output.write(bytes(4000))
+    task.run()
+    assert struct.unpack('1000I', output.read()) == tuple(range(1000))
+
+    with pytest.raises(ValueError):
+        task.autotune(compute_shader=compute_shader, size=1000, candidates=[1 << 20])
@@ -0,0 +1,22 @@
+import os
+
+import pytest
+
+
+def test_buffer_write_file(instance, tmp_path):
+    data = os.urandom(5 * 1024 * 1024 + 123)
+    path = tmp_path / 'data.bin'
+    path.write_bytes(data)
+
+    buffer = instance.buffer('storage_buffer', len(data) + 16, readable=True)
+    buffer.write_file(str(path), offset=16)
+    assert buffer.read()[16:] == data
+
+    buffer.write_file(str(path), file_offset=100, size=1000, readahead=False)
+    assert buffer.read()[:1000] == data[100:1100]
+
+    with pytest.raises(ValueError):
+        buffer.write_file(str(path), file_offset=100, size=2 ** 64 - 50)
+
+    with pytest.raises(ValueError):
+        buffer.write_file(str(path), offset=2 ** 64 - 50, size=100)
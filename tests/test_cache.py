@@ -0,0 +1,59 @@
+import gc
+import weakref
+
+import glnext
+import pytest
+
+
+def test_cache_path(tmp_path):
+    path = tmp_path / 'pipeline.cache'
+    instance = glnext.instance(cache_path=str(path))
+    instance.save_cache()
+    assert path.exists()
+    data = path.read_bytes()
+    assert instance.cache()[:32] == data[:32]
+
+    path.write_bytes(b'invalid')
+    instance = glnext.instance(cache_path=str(path))
+    instance.save_cache()
+    assert path.read_bytes()[:32] == data[:32]
+
+
+def test_cache_path_released(tmp_path):
+    path = tmp_path / 'pipeline.cache'
+    instance = glnext.instance(cache_path=str(path))
+    ref = weakref.ref(instance)
+    del instance
+    gc.collect()
+    assert ref() is None
+    assert path.exists()
+
+
+def test_save_cache_without_path(instance):
+    with pytest.raises(ValueError):
+        instance.save_cache()
+
+
+def test_tuning_cache(tmp_path):
+    from glnext_compiler import glsl
+
+    path = tmp_path / 'pipeline.cache'
+    instance = glnext.instance(cache_path=str(path))
+    task = instance.task()
+    task.autotune(
+        compute_shader=glsl('''
+            #version 450
+            #pragma shader_stage(compute)
+
+            layout (local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+            void main() {
+            }
+        '''),
+        size=256,
+        candidates=[16, 64],
+    )
+    instance.save_cache()
+    lines = (tmp_path / 'pipeline.cache.tuning').read_text().splitlines()
+    assert len(lines) == 1
+    assert lines[0].split()[1:] in (['16', '1', '1'], ['64', '1', '1'])
@@ -0,0 +1,196 @@
+import struct
+
+import pytest
+from glnext_compiler import glsl
+
+
+def test_dispatch_indirect(instance):
+    task = instance.task()
+
+    indirect = instance.buffer('indirect_buffer', 12)
+
+    task.compute(
+        compute_shader=glsl('''
+            #version 450
+            #pragma shader_stage(compute)
+
+            layout (local_size_x = 1) in;
+
+            layout (binding = 0) buffer Indirect {
+                uint group_count[3];
+            };
+
+            void main() {
+                group_count = uint[](2, 3, 1);
+            }
+        '''),
+        compute_count=1,
+        bindings=[{'binding': 0, 'type': 'storage_buffer', 'buffer': indirect}],
+    )
+
+    pipeline = task.compute(
+        compute_shader=glsl('''
+            #version 450
+            #pragma shader_stage(compute)
+
+            layout (local_size_x = 1) in;
+
+            layout (binding = 0) buffer Output {
+                uint output_value[];
+            };
+
+            void main() {
+                atomicAdd(output_value[0], 1);
+                atomicAdd(output_value[1], gl_WorkGroupID.y);
+            }
+        '''),
+        indirect_buffer=indirect,
+        bindings=[{'binding': 0, 'name': 'output', 'type': 'storage_buffer', 'size': 8}],
+    )
+
+    pipeline['output'].write(struct.pack('II', 0, 0))
+    task.run()
+    assert struct.unpack('II', pipeline['output'].read()) == (6, 6)
+
+    with pytest.raises(ValueError):
+        task.compute(
+            compute_shader=glsl('''
+                #version 450
+                #pragma shader_stage(compute)
+
+                layout (local_size_x = 1) in;
+
+                void main() {
+                }
+            '''),
+            indirect_buffer=instance.buffer('storage_buffer', 12),
+        )
+
+
+def test_compute_dependency(instance):
+    task = instance.task()
+
+    shared = instance.buffer('storage_buffer', 16)
+
+    task.compute(
+        compute_shader=glsl('''
+            #version 450
+            #pragma shader_stage(compute)
+
+            layout (local_size_x = 1) in;
+
+            layout (binding = 0) buffer Shared {
+                uint shared_data[];
+            };
+
+            void main() {
+                shared_data[gl_GlobalInvocationID.x] = gl_GlobalInvocationID.x + 1;
+            }
+        '''),
+        compute_count=4,
+        bindings=[{'binding': 0, 'type': 'output_buffer', 'buffer': shared}],
+    )
+
+    pipeline = task.compute(
+        compute_shader=glsl('''
+            #version 450
+            #pragma shader_stage(compute)
+
+            layout (local_size_x = 1) in;
+
+            layout (binding = 0) buffer Shared {
+                uint shared_data[];
+            };
+
+            layout (binding = 1) buffer Output {
+                uint output_data[];
+            };
+
+            void main() {
+                output_data[gl_GlobalInvocationID.x] = shared_data[gl_GlobalInvocationID.x] * 10;
+            }
+        '''),
+        compute_count=4,
+        bindings=[
+            {'binding': 0, 'type': 'input_buffer', 'buffer': shared},
+            {'binding': 1, 'name': 'output', 'type': 'output_buffer', 'size': 16},
+        ],
+    )
+
+    task.run()
+    assert struct.unpack('4I', pipeline['output'].read()) == (10, 20, 30, 40)
+
+
+def test_compute_dependency_unrelated_write(instance):
+    task = instance.task()
+
+    first = instance.buffer('storage_buffer', 16)
+    second = instance.buffer('storage_buffer', 16)
+
+    fill_shader = glsl('''
+        #version 450
+        #pragma shader_stage(compute)
+
+        layout (local_size_x = 1) in;
+
+        layout (binding = 0) buffer Output {
+            uint output_data[];
+        };
+
+        void main() {
+            output_data[gl_GlobalInvocationID.x] = gl_GlobalInvocationID.x + 1;
+        }
+    ''')
+
+    copy_shader = glsl('''
+        #version 450
+        #pragma shader_stage(compute)
+
+        layout (local_size_x = 1) in;
+
+        layout (binding = 0) buffer Input {
+            uint input_data[];
+        };
+
+        layout (binding = 1) buffer Output {
+            uint output_data[];
+        };
+
+        void main() {
+            output_data[gl_GlobalInvocationID.x] = input_data[gl_GlobalInvocationID.x] * 10;
+        }
+    ''')
+
+    # The barrier before the write of the second buffer must not drop the pending write of the first one.
+    task.compute(
+        compute_shader=fill_shader,
+        compute_count=4,
+        bindings=[{'binding': 0, 'type': 'output_buffer', 'buffer': first}],
+    )
+
+    task.compute(
+        compute_shader=copy_shader,
+        compute_count=4,
+        bindings=[
+            {'binding': 0, 'type': 'input_buffer', 'buffer': second},
+            {'binding': 1, 'type': 'output_buffer', 'size': 16},
+        ],
+    )
+
+    task.compute(
+        compute_shader=fill_shader,
+        compute_count=4,
+        bindings=[{'binding': 0, 'type': 'output_buffer', 'buffer': second}],
+    )
+
+    pipeline = task.compute(
+        compute_shader=copy_shader,
+        compute_count=4,
+        bindings=[
+            {'binding': 0, 'type': 'input_buffer', 'buffer': first},
+            {'binding': 1, 'name': 'output', 'type': 'output_buffer', 'size': 16},
+        ],
+    )
+
+    task.run()
+    assert struct.unpack('4I', pipeline['output'].read()) == (10, 20, 30, 40)
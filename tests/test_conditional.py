@@ -0,0 +1,55 @@
+import struct
+
+import pytest
+from glnext_compiler import glsl
+
+
+def test_condition_buffer(instance):
+    task = instance.task()
+
+    condition = instance.buffer('condition_buffer', 8)
+    condition.write(struct.pack('II', 0, 1))
+
+    compute_shader = glsl('''
+        #version 450
+        #pragma shader_stage(compute)
+
+        layout (local_size_x = 1) in;
+
+        layout (binding = 0) buffer Output {
+            uint output_value;
+        };
+
+        void main() {
+            output_value = 1;
+        }
+    ''')
+
+    skipped = task.compute(
+        compute_shader=compute_shader,
+        compute_count=1,
+        condition_buffer=condition,
+        condition_offset=0,
+        bindings=[{'binding': 0, 'name': 'output', 'type': 'storage_buffer', 'size': 4}],
+    )
+
+    executed = task.compute(
+        compute_shader=compute_shader,
+        compute_count=1,
+        condition_buffer=condition,
+        condition_offset=4,
+        bindings=[{'binding': 0, 'name': 'output', 'type': 'storage_buffer', 'size': 4}],
+    )
+
+    skipped['output'].write(struct.pack('I', 0))
+    task.run()
+    assert struct.unpack('I', skipped['output'].read()) == (0,)
+    assert struct.unpack('I', executed['output'].read()) == (1,)
+
+    with pytest.raises(ValueError):
+        task.compute(
+            compute_shader=compute_shader,
+            compute_count=1,
+            condition_buffer=instance.buffer('storage_buffer', 8),
+            bindings=[{'binding': 0, 'name': 'output', 'type': 'storage_buffer', 'size': 4}],
+        )
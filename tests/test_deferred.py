@@ -0,0 +1,41 @@
+import struct
+
+import glnext
+from glnext_compiler import glsl
+
+
+def test_deferred_compute():
+    instance = glnext.instance(deferred=True)
+    task = instance.task()
+
+    pipelines = []
+    for i in range(4):
+        pipelines.append(task.compute(
+            compute_shader=glsl('''
+                #version 450
+                #pragma shader_stage(compute)
+
+                layout (local_size_x = 1) in;
+
+                layout (binding = 0) buffer Output {
+                    uint value;
+                };
+
+                void main() {
+                    value = %d;
+                }
+            ''' % (i + 10)),
+            compute_count=1,
+            bindings=[
+                {
+                    'binding': 0,
+                    'name': 'output',
+                    'type': 'storage_buffer',
+                    'size': 4,
+                },
+            ],
+        ))
+
+    task.run()
+    for i, pipeline in enumerate(pipelines):
+        assert struct.unpack('I', pipeline['output'].read()) == (i + 10,)
@@ -0,0 +1,94 @@
+import struct
+
+from glnext_compiler import glsl
+
+
+def test_draw_list(instance):
+    task = instance.task()
+    framebuffer = task.framebuffer((4, 4), samples=1, depth=False)
+
+    pipeline = framebuffer.render(
+        vertex_shader=glsl('''
+            #version 450
+            #pragma shader_stage(vertex)
+
+            vec2 positions[6] = vec2[](
+                vec2(-1.0, -1.0),
+                vec2(1.0, -1.0),
+                vec2(-1.0, 1.0),
+                vec2(-1.0, 1.0),
+                vec2(1.0, -1.0),
+                vec2(1.0, 1.0)
+            );
+
+            void main() {
+                gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+            }
+        '''),
+        fragment_shader=glsl('''
+            #version 450
+            #pragma shader_stage(fragment)
+
+            layout (location = 0) out vec4 out_color;
+
+            void main() {
+                out_color = vec4(1.0, 1.0, 1.0, 1.0);
+            }
+        '''),
+        draw_list=[(0, 3, 0)],
+        indirect_count=2,
+    )
+
+    task.run()
+    assert framebuffer.output[0].read() != b'\xff' * 64
+
+    pipeline.update(draw_list=[(0, 3, 0), (0, 3, 3)])
+    task.run()
+    assert framebuffer.output[0].read() == b'\xff' * 64
+
+
+def test_culling(instance):
+    task = instance.task()
+    framebuffer = task.framebuffer((4, 4), samples=1, depth=False)
+
+    pipeline = framebuffer.render(
+        vertex_shader=glsl('''
+            #version 450
+            #pragma shader_stage(vertex)
+
+            layout (location = 0) in vec4 in_color;
+            layout (location = 0) out vec4 out_color;
+
+            vec2 positions[3] = vec2[](
+                vec2(-1.0, -1.0),
+                vec2(3.0, -1.0),
+                vec2(-1.0, 3.0)
+            );
+
+            void main() {
+                gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+                out_color = in_color;
+            }
+        '''),
+        fragment_shader=glsl('''
+            #version 450
+            #pragma shader_stage(fragment)
+
+            layout (location = 0) in vec4 in_color;
+            layout (location = 0) out vec4 out_color;
+
+            void main() {
+                out_color = in_color;
+            }
+        '''),
+        instance_format='4f',
+        vertex_count=3,
+        instance_count=2,
+        culling=True,
+    )
+
+    pipeline['instance_buffer'].write(struct.pack('8f', 1.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 1.0))
+    pipeline['bounds_buffer'].write(struct.pack('8f', 0.0, 0.0, 0.5, 0.1, 5.0, 0.0, 0.5, 0.1))
+
+    task.run()
+    assert framebuffer.output[0].read() == b'\xff\x00\x00\xff' * 16
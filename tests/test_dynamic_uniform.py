@@ -0,0 +1,69 @@
+import struct
+
+import pytest
+from glnext_compiler import glsl
+
+
+def test_dynamic_uniform_buffer(instance):
+    task = instance.task()
+
+    compute_shader = glsl('''
+        #version 450
+        #pragma shader_stage(compute)
+
+        layout (local_size_x = 1) in;
+
+        layout (binding = 0) uniform Input {
+            uint value;
+        };
+
+        layout (binding = 1) buffer Output {
+            uint output_value;
+        };
+
+        void main() {
+            output_value = value;
+        }
+    ''')
+
+    pipeline = task.compute(
+        compute_shader=compute_shader,
+        compute_count=1,
+        bindings=[
+            {
+                'binding': 0,
+                'name': 'input',
+                'type': 'dynamic_uniform_buffer',
+                'size': 4,
+            },
+            {
+                'binding': 1,
+                'name': 'output',
+                'type': 'storage_buffer',
+                'size': 4,
+            },
+        ],
+    )
+
+    for value in [10, 20, 30, 40, 50]:
+        pipeline.update(input=struct.pack('I', value))
+        task.run()
+        assert struct.unpack('I', pipeline['output'].read()) == (value,)
+
+    with pytest.raises(ValueError):
+        pipeline.update(input=b'\x00\x00')
+
+    with pytest.raises(ValueError):
+        task.compute(
+            compute_shader=compute_shader,
+            compute_count=1,
+            bindings=[{'binding': 0, 'type': 'dynamic_uniform_buffer', 'size': 4}],
+        )
+
+    with instance.group(buffer=1024):
+        for value in [10, 20, 30, 40]:
+            pipeline.update(input=struct.pack('I', value))
+            task.run()
+
+        with pytest.raises(RuntimeError):
+            pipeline.update(input=struct.pack('I', 50))
@@ -0,0 +1,115 @@
+from glnext_compiler import glsl
+from shaders import FULLSCREEN_VERTEX_SHADER, RED_FRAGMENT_SHADER
+
+
+def test_multiview(instance):
+    task = instance.task()
+    framebuffer = task.framebuffer((4, 4), samples=1, layers=2, depth=False, multiview=True)
+
+    framebuffer.render(
+        vertex_shader=FULLSCREEN_VERTEX_SHADER,
+        fragment_shader=glsl('''
+            #version 450
+            #extension GL_EXT_multiview : require
+            #pragma shader_stage(fragment)
+
+            layout (push_constant) uniform Layer {
+                uint layer;
+            };
+
+            layout (location = 0) out vec4 out_color;
+
+            void main() {
+                out_color = layer + gl_ViewIndex == 0 ? vec4(1.0, 0.0, 0.0, 1.0) : vec4(0.0, 0.0, 1.0, 1.0);
+            }
+        '''),
+        vertex_count=3,
+    )
+
+    task.run()
+    assert framebuffer.output[0].read() == b'\xff\x00\x00\xff' * 16 + b'\x00\x00\xff\xff' * 16
+
+
+def test_dynamic_rendering(instance):
+    task = instance.task()
+    framebuffer = task.framebuffer((4, 4), samples=1, dynamic=True)
+
+    framebuffer.render(
+        vertex_shader=FULLSCREEN_VERTEX_SHADER,
+        fragment_shader=RED_FRAGMENT_SHADER,
+        vertex_count=3,
+    )
+
+    task.run()
+    assert framebuffer.output[0].read() == b'\xff\x00\x00\xff' * 16
+
+
+def test_load_op(instance):
+    task = instance.task()
+    framebuffer = task.framebuffer((4, 4), samples=1, depth=False, load='load')
+
+    pipeline = framebuffer.render(
+        vertex_shader=FULLSCREEN_VERTEX_SHADER,
+        fragment_shader=RED_FRAGMENT_SHADER,
+        vertex_count=3,
+    )
+
+    task.run()
+    pipeline.update(vertex_count=0)
+    task.run()
+    assert framebuffer.output[0].read() == b'\xff\x00\x00\xff' * 16
+
+
+def test_subpasses(instance):
+    task = instance.task()
+    framebuffer = task.framebuffer(
+        (4, 4),
+        format='4p 4p',
+        samples=1,
+        depth=False,
+        store='dont_care store',
+        subpasses=[{'outputs': [0]}, {'inputs': [0], 'outputs': [1]}],
+    )
+
+    framebuffer.render(
+        vertex_shader=FULLSCREEN_VERTEX_SHADER,
+        fragment_shader=glsl('''
+            #version 450
+            #pragma shader_stage(fragment)
+
+            layout (location = 0) out vec4 out_color;
+
+            void main() {
+                out_color = vec4(0.0, 1.0, 0.0, 1.0);
+            }
+        '''),
+        vertex_count=3,
+    )
+
+    framebuffer.render(
+        vertex_shader=FULLSCREEN_VERTEX_SHADER,
+        fragment_shader=glsl('''
+            #version 450
+            #pragma shader_stage(fragment)
+
+            layout (input_attachment_index = 0, binding = 0) uniform subpassInput GBuffer;
+
+            layout (location = 0) out vec4 out_color;
+
+            void main() {
+                out_color = subpassLoad(GBuffer).gbra;
+            }
+        '''),
+        vertex_count=3,
+        subpass=1,
+        bindings=[
+            {
+                'binding': 0,
+                'type': 'input_attachment',
+                'images': [{'image': framebuffer.output[0]}],
+            },
+        ],
+    )
+
+    task.run()
+    assert framebuffer.output[1].read() == b'\xff\x00\x00\xff' * 16
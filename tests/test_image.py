@@ -1,4 +1,5 @@
 import os
+import struct
 import pytest
 
 
@@ -50,3 +51,67 @@ def test_image_mipmaps(instance):
     data = os.urandom(64)
     image = instance.image((4, 4), levels=4, mode='texture')
     image.write(data)
+
+
+def test_image_read_flip_y(instance):
+    data = os.urandom(64)
+    image = instance.image((4, 4), mode='output')
+    image.write(data)
+    rows = [data[i * 16:i * 16 + 16] for i in range(4)]
+    assert image.read(flip_y=True) == b''.join(reversed(rows))
+
+
+def test_image_read_format(instance):
+    data = os.urandom(64)
+    image = instance.image((4, 4), mode='output')
+    image.write(data)
+    assert image.read(format='3p') == b''.join(data[i:i + 3] for i in range(0, 64, 4))
+    red = data[0::4]
+    assert image.read(format='1p', flip_y=True) == b''.join(red[i * 4:i * 4 + 4] for i in reversed(range(4)))
+
+
+def test_image_read_invalid_format(instance):
+    image = instance.image((4, 4), mode='output')
+    with pytest.raises(ValueError):
+        image.read(format='4x')
+
+
+@pytest.mark.parametrize('filter, expected', [('box', 2.5), ('min', 1.0), ('max', 4.0), ('kaiser', 2.5)])
+def test_image_mipmap_filter(instance, filter, expected):
+    from glnext_compiler import glsl
+
+    image = instance.image((2, 2), '1f', levels=2, mode='texture', filter=filter)
+    image.write(struct.pack('4f', 1.0, 2.0, 3.0, 4.0))
+
+    task = instance.task()
+    pipeline = task.compute(
+        compute_shader=glsl('''
+            #version 450
+            #pragma shader_stage(compute)
+
+            layout (local_size_x = 1) in;
+
+            layout (binding = 0) uniform sampler2D Texture;
+
+            layout (binding = 1) buffer Output {
+                float output_value;
+            };
+
+            void main() {
+                output_value = texelFetch(Texture, ivec2(0, 0), 1).r;
+            }
+        '''),
+        compute_count=1,
+        bindings=[
+            {'binding': 0, 'type': 'sampled_image', 'images': [{'image': image, 'sampler': {}}]},
+            {'binding': 1, 'name': 'output', 'type': 'storage_buffer', 'size': 4},
+        ],
+    )
+
+    task.run()
+    assert struct.unpack('f', pipeline['output'].read())[0] == pytest.approx(expected)
+
+
+def test_image_mipmap_invalid_filter(instance):
+    with pytest.raises(ValueError):
+        instance.image((4, 4), levels=4, mode='texture', filter='cubic')
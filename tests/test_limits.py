@@ -0,0 +1,15 @@
+def test_limits(instance):
+    limits = instance.limits
+    assert len(limits['max_compute_work_group_size']) == 3
+    assert len(limits['max_compute_work_group_count']) == 3
+    assert limits['max_compute_work_group_invocations'] >= 128
+    assert limits['max_compute_shared_memory_size'] >= 16384
+    assert limits['timestamp_period'] >= 0.0
+    assert limits['subgroup_size'] == 0 or limits['subgroup_size'] & (limits['subgroup_size'] - 1) == 0
+
+
+def test_features(instance):
+    features = instance.features
+    assert all(isinstance(value, bool) for value in features.values())
+    assert features['subgroup_basic'] or not features['subgroup_arithmetic']
+    assert 'shader_float16' in features and 'timestamps' in features
@@ -0,0 +1,40 @@
+import glnext
+import pytest
+from shaders import FULLSCREEN_VERTEX_SHADER, RED_FRAGMENT_SHADER
+
+
+@pytest.mark.parametrize('deferred', [False, True])
+def test_topology_reuses_library_parts(deferred):
+    instance = glnext.instance(deferred=deferred)
+    if not instance.features['graphics_pipeline_library']:
+        pytest.skip('graphics_pipeline_library is not supported')
+
+    task = instance.task()
+    first = task.framebuffer((4, 4), samples=1, depth=False)
+    second = task.framebuffer((4, 4), samples=1, depth=False)
+
+    first.render(
+        vertex_shader=FULLSCREEN_VERTEX_SHADER,
+        fragment_shader=RED_FRAGMENT_SHADER,
+        vertex_count=3,
+        topology='triangles',
+    )
+
+    task.run()
+    before = instance.stats
+
+    second.render(
+        vertex_shader=FULLSCREEN_VERTEX_SHADER,
+        fragment_shader=RED_FRAGMENT_SHADER,
+        vertex_count=3,
+        topology='triangle_strip',
+    )
+
+    task.run()
+    assert first.output[0].read() == b'\xff\x00\x00\xff' * 16
+    assert second.output[0].read() == b'\xff\x00\x00\xff' * 16
+
+    stats = instance.stats
+    assert before['pipeline_libraries'] == 4
+    assert stats['pipeline_libraries'] - before['pipeline_libraries'] == 1
+    assert stats['pipelines'] - before['pipelines'] == 1
@@ -0,0 +1,32 @@
+import struct
+
+
+def test_primitives(instance):
+    task = instance.task()
+
+    data = instance.buffer('storage_buffer', 16, readable=True)
+    mask = instance.buffer('storage_buffer', 16)
+    keys = instance.buffer('storage_buffer', 16, readable=True)
+    values = instance.buffer('storage_buffer', 16, readable=True)
+
+    scan = task.scan(data, 4)
+    exclusive = task.scan(data, 4, exclusive=True)
+    total = task.reduce(data, 4)
+    minimum = task.reduce(data, 4, op='min')
+    compact, compact_count = task.compact(data, 4, mask=mask)
+    task.sort(keys, 4, key_format='i', values=values)
+
+    data.write(struct.pack('4I', 3, 1, 4, 1))
+    mask.write(struct.pack('4I', 0, 1, 1, 0))
+    keys.write(struct.pack('4i', 5, -2, 7, -2))
+    values.write(struct.pack('4I', 0, 1, 2, 3))
+    task.run()
+
+    assert struct.unpack('4I', scan.read()) == (3, 4, 8, 9)
+    assert struct.unpack('4I', exclusive.read()) == (0, 3, 4, 8)
+    assert struct.unpack('I', total.read()) == (9,)
+    assert struct.unpack('I', minimum.read()) == (1,)
+    assert struct.unpack('I', compact_count.read()) == (2,)
+    assert struct.unpack('2I', compact.read()[:8]) == (1, 4)
+    assert struct.unpack('4i', keys.read()) == (-2, -2, 5, 7)
+    assert struct.unpack('4I', values.read()) == (1, 3, 0, 2)
@@ -0,0 +1,42 @@
+import struct
+
+from glnext_compiler import glsl
+
+
+def test_push_constants(instance):
+    task = instance.task()
+
+    pipeline = task.compute(
+        compute_shader=glsl('''
+            #version 450
+            #pragma shader_stage(compute)
+
+            layout (local_size_x = 1) in;
+
+            layout (push_constant) uniform Parameters {
+                uint value;
+            };
+
+            layout (binding = 0) buffer Output {
+                uint output_value;
+            };
+
+            void main() {
+                output_value = value;
+            }
+        '''),
+        compute_count=1,
+        push_constants=4,
+        bindings=[
+            {
+                'binding': 0,
+                'name': 'output',
+                'type': 'storage_buffer',
+                'size': 4,
+            },
+        ],
+    )
+
+    pipeline.update(push_constants=struct.pack('I', 1234))
+    task.run()
+    assert struct.unpack('I', pipeline['output'].read()) == (1234,)
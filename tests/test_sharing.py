@@ -0,0 +1,90 @@
+import struct
+
+from glnext_compiler import glsl
+from shaders import FULLSCREEN_VERTEX_SHADER, RED_FRAGMENT_SHADER
+
+SPECIALIZED_FRAGMENT_SHADER = glsl('''
+    #version 450
+    #pragma shader_stage(fragment)
+
+    layout (constant_id = 0) const float red = 1.0;
+
+    layout (location = 0) out vec4 out_color;
+
+    void main() {
+        out_color = vec4(red, 0.0, 0.0, 1.0);
+    }
+''')
+
+
+def delta(instance, before):
+    stats = instance.stats
+    return {key: stats[key] - before[key] for key in stats}
+
+
+def test_identical_state_is_shared(instance):
+    task = instance.task()
+    before = instance.stats
+
+    framebuffers = [task.framebuffer((4, 4), samples=1, depth=False) for _ in range(2)]
+    for framebuffer in framebuffers:
+        framebuffer.render(
+            vertex_shader=FULLSCREEN_VERTEX_SHADER,
+            fragment_shader=RED_FRAGMENT_SHADER,
+            vertex_count=3,
+        )
+
+    task.run()
+    for framebuffer in framebuffers:
+        assert framebuffer.output[0].read() == b'\xff\x00\x00\xff' * 16
+
+    stats = delta(instance, before)
+    assert stats['shader_modules'] == 2
+    assert stats['pipeline_layouts'] == 1
+    assert stats['render_passes'] == 1
+    assert stats['pipelines'] == 1
+
+
+def test_specialization_separates_pipelines(instance):
+    task = instance.task()
+    before = instance.stats
+
+    framebuffers = [task.framebuffer((4, 4), samples=1, depth=False) for _ in range(2)]
+    for framebuffer, red in zip(framebuffers, [1.0, 0.0]):
+        framebuffer.render(
+            vertex_shader=FULLSCREEN_VERTEX_SHADER,
+            fragment_shader=SPECIALIZED_FRAGMENT_SHADER,
+            vertex_count=3,
+            specialization={0: red},
+        )
+
+    task.run()
+    assert framebuffers[0].output[0].read() == b'\xff\x00\x00\xff' * 16
+    assert framebuffers[1].output[0].read() == b'\x00\x00\x00\xff' * 16
+
+    stats = delta(instance, before)
+    assert stats['shader_modules'] == 2
+    assert stats['render_passes'] == 1
+    assert stats['pipelines'] == 2
+
+
+def test_format_separates_render_passes(instance):
+    task = instance.task()
+    before = instance.stats
+
+    framebuffers = [task.framebuffer((4, 4), format, samples=1, depth=False) for format in ['4p', '4f']]
+    for framebuffer in framebuffers:
+        framebuffer.render(
+            vertex_shader=FULLSCREEN_VERTEX_SHADER,
+            fragment_shader=RED_FRAGMENT_SHADER,
+            vertex_count=3,
+        )
+
+    task.run()
+    assert framebuffers[0].output[0].read() == b'\xff\x00\x00\xff' * 16
+    assert framebuffers[1].output[0].read() == struct.pack('4f', 1.0, 0.0, 0.0, 1.0) * 16
+
+    stats = delta(instance, before)
+    assert stats['shader_modules'] == 2
+    assert stats['render_passes'] == 2
+    assert stats['pipelines'] == 2
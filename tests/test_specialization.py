@@ -0,0 +1,51 @@
+import struct
+
+from glnext_compiler import glsl
+
+
+def test_specialization_constants(instance):
+    task = instance.task()
+
+    compute_shader = glsl('''
+        #version 450
+        #pragma shader_stage(compute)
+
+        layout (local_size_x = 1) in;
+
+        layout (constant_id = 0) const uint value_uint = 1;
+        layout (constant_id = 1) const float value_float = 1.0;
+        layout (constant_id = 2) const bool value_bool = false;
+
+        layout (binding = 0) buffer Output {
+            uint output_uint;
+            float output_float;
+            uint output_bool;
+        };
+
+        void main() {
+            output_uint = value_uint;
+            output_float = value_float;
+            output_bool = value_bool ? 1 : 0;
+        }
+    ''')
+
+    bindings = [
+        {
+            'binding': 0,
+            'name': 'output',
+            'type': 'storage_buffer',
+            'size': 12,
+        },
+    ]
+
+    default = task.compute(compute_shader=compute_shader, compute_count=1, bindings=bindings)
+    variant = task.compute(
+        compute_shader=compute_shader,
+        compute_count=1,
+        bindings=bindings,
+        specialization={0: 42, 1: 0.5, 2: True},
+    )
+
+    task.run()
+    assert struct.unpack('IfI', default['output'].read()) == (1, 1.0, 0)
+    assert struct.unpack('IfI', variant['output'].read()) == (42, 0.5, 1)
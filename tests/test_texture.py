@@ -0,0 +1,65 @@
+import os
+import struct
+
+import pytest
+
+
+def write_dds(path, width, height, levels, data):
+    header = struct.pack(
+        '<4s7I44x8I4I4x',
+        b'DDS ', 124, 0x2100f, height, width, width * 4, 0, levels,
+        32, 0x41, 0, 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000,
+        0x401008, 0, 0, 0,
+    )
+    with open(path, 'wb') as f:
+        f.write(header + data)
+
+
+def write_ktx2(path, width, height, levels, level_data):
+    offset = 80 + 24 * levels
+    index = b''
+    for data in level_data:
+        index += struct.pack('<3Q', offset, len(data), len(data))
+        offset += len(data)
+    header = b'\xabKTX 20\xbb\r\n\x1a\n' + struct.pack('<9I4I2Q', 37, 1, width, height, 0, 0, 1, levels, 0, 0, 0, 0, 0, 0, 0)
+    with open(path, 'wb') as f:
+        f.write(header + index + b''.join(level_data))
+
+
+def test_load_texture_dds(instance, tmp_path):
+    data = os.urandom(64)
+    write_dds(tmp_path / 'texture.dds', 4, 4, 1, data)
+    image = instance.load_texture(tmp_path / 'texture.dds', mode='output')
+    assert image.size == (4, 4)
+    assert image.read() == data
+
+
+def test_load_texture_ktx2(instance, tmp_path):
+    data = os.urandom(64)
+    write_ktx2(tmp_path / 'texture.ktx2', 4, 4, 1, [data])
+    image = instance.load_texture(tmp_path / 'texture.ktx2', mode='output')
+    assert image.size == (4, 4)
+    assert image.read() == data
+
+
+def test_load_texture_ktx2_levels(instance, tmp_path):
+    level_data = [os.urandom(64), os.urandom(16), os.urandom(4)]
+    write_ktx2(tmp_path / 'texture.ktx2', 4, 4, 3, level_data)
+    image = instance.load_texture(tmp_path / 'texture.ktx2')
+    assert image.size == (4, 4)
+    with pytest.raises(ValueError):
+        instance.load_texture(tmp_path / 'texture.ktx2', mode='output')
+
+
+def test_load_texture_ktx2_invalid_level(instance, tmp_path):
+    level_data = [os.urandom(64), os.urandom(8), os.urandom(4)]
+    write_ktx2(tmp_path / 'texture.ktx2', 4, 4, 3, level_data)
+    with pytest.raises(ValueError):
+        instance.load_texture(tmp_path / 'texture.ktx2')
+
+
+def test_load_texture_invalid(instance, tmp_path):
+    with open(tmp_path / 'texture.png', 'wb') as f:
+        f.write(os.urandom(256))
+    with pytest.raises(ValueError):
+        instance.load_texture(tmp_path / 'texture.png')